@@ -14,6 +14,7 @@
 #include <zephyr/drivers/pinctrl.h>
 #include <zephyr/drivers/adc.h>
 #include <zephyr/drivers/pwm.h>
+#include <zephyr/random/random.h>
 
 /* Application specific headers */
 #include "bl_zephyr_osal_cfg.h"
@@ -24,7 +25,8 @@ LOG_MODULE_REGISTER(gateway_m4, LOG_LEVEL_INF);
 /* =============================================================================
  * CORE IDENTIFICATION AND CONFIGURATION
  * =============================================================================*/
-#ifdef CONFIG_SOC_MIMXRT1166_CM4
+/* CORE_CM4 comes with bl_isw: set from the SoC on target, from BL_CORE on native_sim */
+#if defined(CORE_CM4)
     #define CURRENT_CORE "M4"
     #define IS_M4_CORE 1
 #else
@@ -62,7 +64,6 @@ LOG_MODULE_REGISTER(gateway_m4, LOG_LEVEL_INF);
 #define FOTA_TRIGGER_PRIORITY          9
 
 /* Task Periods (in milliseconds) */
-#define OPENAMP_COMM_PERIOD            10    /* 100Hz */
 #define FAN_CONTROL_PERIOD             20    /* 50Hz */
 #define FREQ_BUSHING_ACQ_PERIOD        50    /* 20Hz */
 #define ENV_ACQ_PERIOD                100    /* 10Hz */
@@ -74,48 +75,26 @@ LOG_MODULE_REGISTER(gateway_m4, LOG_LEVEL_INF);
  * HARDWARE CONFIGURATION
  * =============================================================================*/
 
-/* ADC Configuration */
-#define ADC_DEVICE_NAME         DT_LABEL(DT_NODELABEL(adc1))
+/* ADC Configuration (absent on native_sim, where samples are simulated) */
+#define ADC_NODE                DT_ALIAS(adc0)
 #define ADC_RESOLUTION          12
 #define ADC_GAIN               ADC_GAIN_1
 #define ADC_REFERENCE          ADC_REF_INTERNAL
 #define ADC_ACQUISITION_TIME   ADC_ACQ_TIME_DEFAULT
+#define ADC_CHANNELS           3      /* Voltage, current, frequency: channels 0..2 */
 
-/* PWM Configuration for Fan Control */
-#define PWM_DEVICE_NAME        DT_LABEL(DT_NODELABEL(pwm1))
+/* Calibration: corrected = (raw - offset) * gain, gain in Q16. A step
+ * measures the running average of the channel, over about
+ * 2^CALIB_AVG_SHIFT conversions.
+ */
+#define CALIB_GAIN_ONE         (1 << 16)
+#define CALIB_AVG_SHIFT        4
+
+/* PWM Configuration for Fan Control (absent on native_sim) */
+#define PWM_NODE               DT_ALIAS(pwm0)
 #define PWM_CHANNEL            0
 #define PWM_PERIOD_NS          20000  /* 50kHz */
 
-/* =============================================================================
- * DATA STRUCTURES
- * =============================================================================*/
-
-/* Sensor data structure */
-typedef struct {
-    uint32_t timestamp;
-    float frequency;
-    float bushing_voltage;
-    float bushing_current;
-    float temperature;
-    float humidity;
-    float vibration;
-} sensor_data_t;
-
-/* Fan control structure */
-typedef struct {
-    bool enabled;
-    uint8_t speed_percent;
-    uint8_t mode;  /* 0: Auto, 1: Manual */
-    float target_temperature;
-} fan_control_t;
-
-/* Alarm status structure */
-typedef struct {
-    uint32_t active_alarms;
-    uint32_t alarm_history;
-    uint8_t severity_level;
-} alarm_status_t;
-
 /* =============================================================================
  * GLOBAL VARIABLES
  * =============================================================================*/
@@ -125,14 +104,29 @@ static bool system_initialized = false;
 static bool core_sync_complete = false;
 
 /* Sensor data */
-static sensor_data_t current_sensor_data = {0};
-static fan_control_t fan_control_state = {
+/* Read by the control and alarm loops every cycle: kept in DTCM */
+static BL_FAST_DATA bl_sensor_data_t current_sensor_data = {0};
+static BL_FAST_DATA bl_msg_fan_control_t fan_control_state = {
     .enabled = true,
     .speed_percent = 50,
     .mode = 0,
     .target_temperature = 25.0
 };
-static alarm_status_t alarm_status = {0};
+static BL_FAST_DATA bl_msg_alarm_status_t alarm_status = {0};
+
+/* ADC conversion results and the stream sample built from them; the
+ * conversion-complete interrupt defers the streaming to adc_done_isr
+ */
+static BL_DMA_BUFFER uint16_t adc_buffer[ADC_CHANNELS];  /* Voltage, current, frequency */
+static bl_adc_sample_t adc_sample;
+
+/* Calibration set by M7, applied to every conversion */
+static struct k_spinlock calib_lock;
+static int32_t calib_offset[ADC_CHANNELS];
+static int32_t calib_gain[ADC_CHANNELS] = { [0 ... ADC_CHANNELS - 1] = CALIB_GAIN_ONE };
+static uint16_t calib_flags;
+static int32_t adc_avg[ADC_CHANNELS];     /* Raw average << CALIB_AVG_SHIFT */
+static bool adc_avg_valid;
 
 /* Task handles */
 static struct k_thread openamp_comm_thread;
@@ -156,75 +150,87 @@ K_THREAD_STACK_DEFINE(fota_trigger_stack, FOTA_TRIGGER_STACK_SIZE);
 K_MUTEX_DEFINE(sensor_data_mutex);
 K_MUTEX_DEFINE(fan_control_mutex);
 
+/* Conversion complete: streamed from a category 2 handler thread */
+static void adc_done_handler(void *arg);
+BL_OSAL_ISR_CAT2_DEFINE(adc_done_isr, adc_done_handler, NULL, BL_OS_ISR_THREAD_PRIORITY);
+
 /* =============================================================================
  * TASK IMPLEMENTATIONS
  * =============================================================================*/
 
 /**
- * @brief OpenAMP Communication Task (M4)
- * Handles inter-core communication with M7
+ * @brief Fan control command from M7
  */
-static void openamp_comm_m4_task(void *p1, void *p2, void *p3)
+static void ipc_fan_control_handler(const bl_ipc_msg_t *msg, void *ctx)
 {
-    bl_ipc_msg_t msg;
-    int ret;
-    uint32_t msg_count = 0;
+    /* Update fan control settings */
+    k_mutex_lock(&fan_control_mutex, K_FOREVER);
+    fan_control_state = *bl_msg_fan_control_decode(msg);
+    k_mutex_unlock(&fan_control_mutex);
+}
 
-    LOG_INF("OpenAMP M4 task started");
+/**
+ * @brief Calibration command from M7, answered when the step is done
+ *
+ * The channel's input is expected to be at the reference while the step
+ * runs. Offset: the average reading is taken as the reference. Gain: the
+ * offset-corrected average is scaled to the reference.
+ */
+static void ipc_calibration_handler(const bl_ipc_msg_t *msg, void *ctx)
+{
+    const bl_msg_calibration_t *cmd = bl_msg_calibration_decode(msg);
+    k_spinlock_key_t key;
+    int32_t mean;
+    int32_t span;
+    int ret = 0;
+
+    if (cmd->channel >= ADC_CHANNELS) {
+        bl_rpc_reply(msg, -EINVAL);
+        return;
+    }
 
-    while (1) {
-        /* Check for messages from M7 */
-        ret = bl_ipc_recv_msg(&msg, K_MSEC(OPENAMP_COMM_PERIOD/2));
-        if (ret == 0) {
-            LOG_DBG("Received message from M7: type=%d, len=%d",
-                    msg.msg_type, msg.data_len);
-
-            /* Process message based on type */
-            switch (msg.msg_type) {
-                case BL_MSG_TYPE_FAN_CONTROL:
-                    /* Update fan control settings */
-                    k_mutex_lock(&fan_control_mutex, K_FOREVER);
-                    memcpy(&fan_control_state, msg.data,
-                           MIN(msg.data_len, sizeof(fan_control_t)));
-                    k_mutex_unlock(&fan_control_mutex);
-                    break;
-
-                case BL_MSG_TYPE_CALIBRATION:
-                    /* Handle calibration command */
-                    LOG_INF("Received calibration command");
-                    break;
-
-                case BL_MSG_TYPE_FOTA_TRIGGER:
-                    /* Handle FOTA trigger */
-                    LOG_INF("Received FOTA trigger");
-                    break;
-
-                default:
-                    LOG_WRN("Unknown message type: %d", msg.msg_type);
-                    break;
-            }
+    key = k_spin_lock(&calib_lock);
+    mean = adc_avg[cmd->channel] >> CALIB_AVG_SHIFT;
+    if (!adc_avg_valid) {
+        ret = -EAGAIN;
+    } else if (cmd->command == BL_CALIB_CMD_OFFSET) {
+        calib_offset[cmd->channel] = mean - (int32_t)cmd->reference;
+    } else if (cmd->command == BL_CALIB_CMD_GAIN) {
+        span = mean - calib_offset[cmd->channel];
+        if (span <= 0 || cmd->reference <= 0.0f) {
+            ret = -ERANGE;
+        } else {
+            calib_gain[cmd->channel] = (int32_t)((cmd->reference * CALIB_GAIN_ONE) / span);
         }
+    } else {
+        ret = -EINVAL;
+    }
+    if (ret == 0) {
+        calib_flags = BL_ADC_SAMPLE_CALIBRATED;
+    }
+    k_spin_unlock(&calib_lock, key);
 
-        /* Send sensor data to M7 periodically */
-        if (++msg_count >= 10) {  /* Every 100ms */
-            msg_count = 0;
-
-            /* Prepare sensor data message */
-            msg.msg_type = BL_MSG_TYPE_SENSOR_DATA;
+    LOG_INF("Calibration command %u on channel %u (reading %d): %d",
+            cmd->command, cmd->channel, mean, ret);
+    bl_rpc_reply(msg, ret);
+}
 
-            k_mutex_lock(&sensor_data_mutex, K_FOREVER);
-            memcpy(msg.data, &current_sensor_data, sizeof(sensor_data_t));
-            msg.data_len = sizeof(sensor_data_t);
-            k_mutex_unlock(&sensor_data_mutex);
+/**
+ * @brief OpenAMP Communication Task (M4)
+ * Handles inter-core communication with M7
+ *
+ * Commands from M7 are dispatched as soon as they arrive. Sensor data
+ * reaches M7 through the sensor mailbox instead of messages.
+ */
+static void openamp_comm_m4_task(void *p1, void *p2, void *p3)
+{
+    LOG_INF("OpenAMP M4 task started");
 
-            /* Send to M7 */
-            ret = bl_ipc_send_msg(&msg);
-            if (ret != 0) {
-                LOG_ERR("Failed to send sensor data: %d", ret);
-            }
-        }
+    bl_ipc_register_handler(BL_MSG_TYPE_FAN_CONTROL, ipc_fan_control_handler, NULL);
+    bl_ipc_register_handler(BL_MSG_TYPE_CALIBRATION, ipc_calibration_handler, NULL);
 
-        k_msleep(OPENAMP_COMM_PERIOD);
+    while (1) {
+        bl_ipc_dispatch(K_FOREVER);
     }
 }
 
@@ -232,20 +238,22 @@ static void openamp_comm_m4_task(void *p1, void *p2, void *p3)
  * @brief Fan Control Task
  * Executes real-time fan control based on temperature and commands
  */
-static void fan_control_task(void *p1, void *p2, void *p3)
+static BL_HOT_CODE void fan_control_task(void *p1, void *p2, void *p3)
 {
     const struct device *pwm_dev;
     uint32_t pulse_width;
+    bl_osal_periodic_t periodic;
 
     LOG_INF("Fan control task started");
 
-    /* Get PWM device */
-    pwm_dev = device_get_binding(PWM_DEVICE_NAME);
-    if (!pwm_dev) {
-        LOG_ERR("PWM device not found");
-        return;
+    /* Get PWM device; without one the control loop runs without output */
+    pwm_dev = DEVICE_DT_GET_OR_NULL(PWM_NODE);
+    if (!pwm_dev || !device_is_ready(pwm_dev)) {
+        LOG_WRN("PWM device not found, fan output disabled");
+        pwm_dev = NULL;
     }
 
+    bl_osal_periodic_init(&periodic, FAN_CONTROL_PERIOD);
     while (1) {
         k_mutex_lock(&fan_control_mutex, K_FOREVER);
 
@@ -270,53 +278,165 @@ static void fan_control_task(void *p1, void *p2, void *p3)
             pulse_width = (PWM_PERIOD_NS * fan_control_state.speed_percent) / 100;
 
             /* Set PWM output */
-            pwm_set_dt(pwm_dev, PWM_CHANNEL, PWM_PERIOD_NS, pulse_width, 0);
+            if (pwm_dev) {
+                pwm_set(pwm_dev, PWM_CHANNEL, PWM_PERIOD_NS, pulse_width, 0);
+            }
 
             LOG_DBG("Fan speed: %d%%", fan_control_state.speed_percent);
         } else {
             /* Fan disabled - set PWM to 0 */
-            pwm_set_dt(pwm_dev, PWM_CHANNEL, PWM_PERIOD_NS, 0, 0);
+            if (pwm_dev) {
+                pwm_set(pwm_dev, PWM_CHANNEL, PWM_PERIOD_NS, 0, 0);
+            }
         }
 
         k_mutex_unlock(&fan_control_mutex);
 
-        k_msleep(FAN_CONTROL_PERIOD);
+        bl_osal_periodic_wait(&periodic);
+    }
+}
+
+/**
+ * @brief ADC sequence callback: conversion complete (ADC interrupt context)
+ */
+static BL_HOT_CODE enum adc_action adc_done_cb(const struct device *dev,
+                                               const struct adc_sequence *sequence,
+                                               uint16_t sampling_index)
+{
+    ARG_UNUSED(dev);
+    ARG_UNUSED(sequence);
+    ARG_UNUSED(sampling_index);
+
+    bl_osal_isr_raise(&adc_done_isr, bl_osal_prof_get_cycles());
+    return ADC_ACTION_CONTINUE;
+}
+
+/**
+ * @brief Correct one raw reading with its channel's calibration (calib_lock held)
+ */
+static BL_HOT_CODE uint16_t adc_calibrate(uint8_t ch, uint16_t raw)
+{
+    int64_t value = (((int64_t)raw - calib_offset[ch]) * calib_gain[ch]) >> 16;
+
+    return (uint16_t)CLAMP(value, 0, BIT_MASK(ADC_RESOLUTION));
+}
+
+/**
+ * @brief Conversion complete, category 2 handler: stream the samples to M7
+ */
+static BL_HOT_CODE void adc_done_handler(void *arg)
+{
+    uint16_t value[ADC_CHANNELS];
+    k_spinlock_key_t key;
+
+    ARG_UNUSED(arg);
+
+    key = k_spin_lock(&calib_lock);
+    for (uint8_t ch = 0; ch < ADC_CHANNELS; ch++) {
+        if (!adc_avg_valid) {
+            adc_avg[ch] = (int32_t)adc_buffer[ch] << CALIB_AVG_SHIFT;
+        } else {
+            adc_avg[ch] += adc_buffer[ch] - (adc_avg[ch] >> CALIB_AVG_SHIFT);
+        }
+        value[ch] = adc_calibrate(ch, adc_buffer[ch]);
+    }
+    adc_avg_valid = true;
+    adc_sample.flags = (adc_sample.flags & ~BL_ADC_SAMPLE_CALIBRATED) | calib_flags;
+    k_spin_unlock(&calib_lock, key);
+
+    adc_sample.timestamp = bl_osal_get_time_us();
+    adc_sample.voltage = value[0];
+    adc_sample.current = value[1];
+    adc_sample.frequency = value[2];
+    if (bl_ipc_stream_write(BL_IPC_STREAM_ADC, &adc_sample, 1) != 1) {
+        LOG_WRN("ADC stream full, sample dropped");
     }
 }
 
 /**
  * @brief Frequency/Bushing Acquisition Task
  * High-speed acquisition of electrical parameters
+ *
+ * Starts a conversion each period; the raw samples reach M7 from the
+ * conversion-complete handler.
  */
-static void freq_bushing_acq_task(void *p1, void *p2, void *p3)
+static BL_HOT_CODE void freq_bushing_acq_task(void *p1, void *p2, void *p3)
 {
+    static const struct adc_sequence_options adc_options = {
+        .callback = adc_done_cb,
+    };
     const struct device *adc_dev;
     struct adc_sequence sequence = {0};
-    uint16_t buffer[3];  /* For voltage, current, frequency measurements */
+    struct adc_channel_cfg channel_cfg = {
+        .gain = ADC_GAIN,
+        .reference = ADC_REFERENCE,
+        .acquisition_time = ADC_ACQUISITION_TIME,
+    };
+    bl_osal_periodic_t periodic;
+    uint16_t ramp = 0;
+    bool adc_ok;
+    int ret;
 
     LOG_INF("Frequency/Bushing acquisition task started");
 
+    ret = bl_osal_isr_init(&adc_done_isr);
+    if (ret != 0) {
+        LOG_ERR("ADC ISR init failed: %d", ret);
+    }
+
     /* Get ADC device */
-    adc_dev = device_get_binding(ADC_DEVICE_NAME);
-    if (!adc_dev) {
-        LOG_ERR("ADC device not found");
-        return;
+    adc_dev = DEVICE_DT_GET_OR_NULL(ADC_NODE);
+    adc_ok = (ret == 0) && adc_dev && device_is_ready(adc_dev);
+
+    for (uint8_t ch = 0; adc_ok && ch < ADC_CHANNELS; ch++) {
+        channel_cfg.channel_id = ch;
+        ret = adc_channel_setup(adc_dev, &channel_cfg);
+        if (ret != 0) {
+            LOG_ERR("ADC channel %u setup failed: %d", ch, ret);
+            adc_ok = false;
+        }
+    }
+
+    if (!adc_ok) {
+        LOG_WRN("ADC not available, streaming a synthetic ramp");
+        adc_sample.flags = BL_ADC_SAMPLE_SYNTHETIC;
     }
 
     /* Configure ADC sequence */
-    sequence.buffer = buffer;
-    sequence.buffer_size = sizeof(buffer);
+    sequence.options = &adc_options;
+    sequence.channels = BIT_MASK(ADC_CHANNELS);
+    sequence.buffer = adc_buffer;
+    sequence.buffer_size = sizeof(adc_buffer);
     sequence.resolution = ADC_RESOLUTION;
 
+    bl_osal_periodic_init(&periodic, FREQ_BUSHING_ACQ_PERIOD);
     while (1) {
-        /* TODO: Implement actual ADC reading and signal processing */
+        if (adc_ok) {
+            ret = adc_read(adc_dev, &sequence);
+            if (ret != 0) {
+                LOG_WRN("ADC read failed: %d", ret);
+            }
+        } else {
+            /* Synthetic ramp, one step per sample, offset per channel */
+            for (uint8_t ch = 0; ch < ADC_CHANNELS; ch++) {
+                adc_buffer[ch] = (uint16_t)(ramp + ch) & BIT_MASK(ADC_RESOLUTION);
+            }
+            ramp++;
+
+            /* Stands in for the conversion-complete interrupt */
+            bl_osal_isr_raise(&adc_done_isr, bl_osal_prof_get_cycles());
+        }
+
+        /* TODO: Derive the processed values from the raw samples */
 
         /* Simulate data acquisition */
         k_mutex_lock(&sensor_data_mutex, K_FOREVER);
         current_sensor_data.frequency = 50.0 + ((float)(sys_rand32_get() % 100) - 50) / 100.0;
         current_sensor_data.bushing_voltage = 230.0 + ((float)(sys_rand32_get() % 20) - 10) / 10.0;
         current_sensor_data.bushing_current = 10.0 + ((float)(sys_rand32_get() % 20) - 10) / 10.0;
-        current_sensor_data.timestamp = k_uptime_get_32();
+        current_sensor_data.timestamp = bl_osal_get_time_us();
+        /* Publish the snapshot to M7; the mutex serialises the publishers */
+        bl_ipc_mailbox_publish(BL_IPC_MAILBOX_SENSOR, &current_sensor_data);
         k_mutex_unlock(&sensor_data_mutex);
 
         LOG_DBG("Freq: %.2f Hz, Voltage: %.1f V, Current: %.1f A",
@@ -324,7 +444,7 @@ static void freq_bushing_acq_task(void *p1, void *p2, void *p3)
                 current_sensor_data.bushing_voltage,
                 current_sensor_data.bushing_current);
 
-        k_msleep(FREQ_BUSHING_ACQ_PERIOD);
+        bl_osal_periodic_wait(&periodic);
     }
 }
 
@@ -334,8 +454,11 @@ static void freq_bushing_acq_task(void *p1, void *p2, void *p3)
  */
 static void env_acq_task(void *p1, void *p2, void *p3)
 {
+    bl_osal_periodic_t periodic;
+
     LOG_INF("Environmental acquisition task started");
 
+    bl_osal_periodic_init(&periodic, ENV_ACQ_PERIOD);
     while (1) {
         /* TODO: Implement actual sensor reading */
 
@@ -344,6 +467,7 @@ static void env_acq_task(void *p1, void *p2, void *p3)
         current_sensor_data.temperature = 25.0 + ((float)(sys_rand32_get() % 100) - 50) / 10.0;
         current_sensor_data.humidity = 60.0 + ((float)(sys_rand32_get() % 40) - 20) / 10.0;
         current_sensor_data.vibration = 0.1 + ((float)(sys_rand32_get() % 10)) / 100.0;
+        bl_ipc_mailbox_publish(BL_IPC_MAILBOX_SENSOR, &current_sensor_data);
         k_mutex_unlock(&sensor_data_mutex);
 
         LOG_DBG("Temp: %.1f°C, Humidity: %.1f%%, Vibration: %.2f g",
@@ -351,7 +475,7 @@ static void env_acq_task(void *p1, void *p2, void *p3)
                 current_sensor_data.humidity,
                 current_sensor_data.vibration);
 
-        k_msleep(ENV_ACQ_PERIOD);
+        bl_osal_periodic_wait(&periodic);
     }
 }
 
@@ -359,13 +483,15 @@ static void env_acq_task(void *p1, void *p2, void *p3)
  * @brief Local Alarm Task
  * Processes local safety alarms and immediate responses
  */
-static void alarm_local_task(void *p1, void *p2, void *p3)
+static BL_HOT_CODE void alarm_local_task(void *p1, void *p2, void *p3)
 {
-    bl_ipc_msg_t msg;
+    bl_ipc_msg_t *tx;
     bool alarm_state_changed = false;
+    bl_osal_periodic_t periodic;
 
     LOG_INF("Local alarm task started");
 
+    bl_osal_periodic_init(&periodic, ALARM_LOCAL_PERIOD);
     while (1) {
         alarm_state_changed = false;
 
@@ -405,10 +531,16 @@ static void alarm_local_task(void *p1, void *p2, void *p3)
 
         /* Send alarm status to M7 if changed */
         if (alarm_state_changed) {
-            msg.msg_type = BL_MSG_TYPE_ALARM_STATUS;
-            memcpy(msg.data, &alarm_status, sizeof(alarm_status_t));
-            msg.data_len = sizeof(alarm_status_t);
-            bl_ipc_send_msg(&msg);
+            /* Alarms are worth waiting briefly for a free buffer */
+            tx = bl_ipc_alloc_tx(BL_MSG_TYPE_ALARM_STATUS, K_MSEC(ALARM_LOCAL_PERIOD / 10));
+            if (tx != NULL) {
+                bl_msg_alarm_status_encode(tx, &alarm_status);
+                if (bl_ipc_commit_tx(tx) != 0) {
+                    LOG_ERR("Failed to send alarm status");
+                }
+            } else {
+                LOG_ERR("No IPC buffer for alarm status");
+            }
         }
 
         /* Update alarm severity */
@@ -418,7 +550,7 @@ static void alarm_local_task(void *p1, void *p2, void *p3)
             alarm_status.severity_level = 0;  /* No alarms */
         }
 
-        k_msleep(ALARM_LOCAL_PERIOD);
+        bl_osal_periodic_wait(&periodic);
     }
 }
 
@@ -428,13 +560,16 @@ static void alarm_local_task(void *p1, void *p2, void *p3)
  */
 static void calib_exec_task(void *p1, void *p2, void *p3)
 {
+    bl_osal_periodic_t periodic;
+
     LOG_INF("Calibration execution task started");
 
+    bl_osal_periodic_init(&periodic, CALIB_EXEC_PERIOD);
     while (1) {
         /* TODO: Implement calibration execution logic */
         LOG_DBG("Calibration execution check");
 
-        k_msleep(CALIB_EXEC_PERIOD);
+        bl_osal_periodic_wait(&periodic);
     }
 }
 
@@ -444,13 +579,16 @@ static void calib_exec_task(void *p1, void *p2, void *p3)
  */
 static void fota_trigger_task(void *p1, void *p2, void *p3)
 {
+    bl_osal_periodic_t periodic;
+
     LOG_INF("FOTA trigger task started");
 
+    bl_osal_periodic_init(&periodic, FOTA_TRIGGER_PERIOD);
     while (1) {
         /* TODO: Implement FOTA trigger logic */
         LOG_DBG("FOTA trigger check");
 
-        k_msleep(FOTA_TRIGGER_PERIOD);
+        bl_osal_periodic_wait(&periodic);
     }
 }
 
@@ -646,7 +784,7 @@ static int bl_isw_data_main_m4_init(void)
     LOG_INF("=== Transformer Gateway M4 Core Initialization ===");
 
     /* Initialize ISW for M4 */
-    bl_isw_init_m4();
+    bl_isw_init();
 
     /* Initialize M4 peripherals */
     ret = init_m4_peripherals();
@@ -22,7 +22,8 @@ LOG_MODULE_REGISTER(gateway_m7, LOG_LEVEL_INF);
 /* =============================================================================
  * CORE IDENTIFICATION AND CONFIGURATION
  * =============================================================================*/
-#ifdef CONFIG_SOC_MIMXRT1166_CM7
+/* CORE_CM7 comes with bl_isw: set from the SoC on target, from BL_CORE on native_sim */
+#if defined(CORE_CM7)
     #define CURRENT_CORE "M7"
     #define IS_M7_CORE 1
 #else
@@ -64,6 +65,7 @@ LOG_MODULE_REGISTER(gateway_m7, LOG_LEVEL_INF);
 /* Data Aggregation Tasks */
 #define FREQ_BUSHING_AGG_STACK_SIZE    3072
 #define FREQ_BUSHING_AGG_PRIORITY      9
+#define FREQ_BUSHING_AGG_BATCH         32    /* Samples per stream read */
 #define ENV_AGG_STACK_SIZE             2048
 #define ENV_AGG_PRIORITY               10
 
@@ -72,7 +74,6 @@ LOG_MODULE_REGISTER(gateway_m7, LOG_LEVEL_INF);
 #define ALARM_CLOUD_PRIORITY           11
 
 /* Task Periods (in milliseconds) */
-#define OPENAMP_COMM_PERIOD            10    /* 100Hz */
 #define MODBUS_POLL_PERIOD            100    /* 10Hz */
 #define LTE_MQTT_PERIOD               500    /* 2Hz */
 #define IEC61850_PERIOD               100    /* 10Hz */
@@ -85,6 +86,26 @@ LOG_MODULE_REGISTER(gateway_m7, LOG_LEVEL_INF);
 #define ENV_AGG_PERIOD               200    /* 5Hz */
 #define ALARM_CLOUD_PERIOD           500    /* 2Hz */
 
+/* Acquisition records from the aggregation task to the logging and
+ * LTE/MQTT tasks, environmental reports to the LTE/MQTT task, and alarm
+ * messages from M4 to the alarm cloud task
+ */
+#define RECORD_QUEUE_LENGTH            4
+#define ENV_REPORT_QUEUE_LENGTH        2
+#define ALARM_QUEUE_LENGTH             8
+
+/* Environmental snapshots averaged into one report (1s at ENV_AGG_PERIOD) */
+#define ENV_REPORT_SNAPSHOTS           5
+
+/* MQTT publications */
+#define MQTT_TOPIC_SAMPLES             "bl/gateway/samples"
+#define MQTT_TOPIC_ENV                 "bl/gateway/env"
+#define MQTT_PAYLOAD_MAX               192
+
+/* Commands to M4 (RPC) */
+#define CALIB_CHANNELS                 3      /* M4 ADC: voltage, current, frequency */
+#define CALIB_RPC_TIMEOUT_MS         500
+
 /* =============================================================================
  * GLOBAL VARIABLES
  * =============================================================================*/
@@ -93,6 +114,50 @@ LOG_MODULE_REGISTER(gateway_m7, LOG_LEVEL_INF);
 static bool system_initialized = false;
 static bool core_sync_complete = false;
 
+/* Calibration sequence requests; one sequence runs at start-up */
+K_SEM_DEFINE(calib_request_sem, 1, 1);
+
+/* Batch of raw samples with the processed values current at the time.
+ * The aggregation task fills it in a pool buffer and shares that buffer
+ * with the logging and LTE/MQTT tasks, each of which drops its reference.
+ */
+typedef struct {
+    bl_sensor_data_t sensor;
+    uint32_t count;
+    bl_adc_sample_t samples[FREQ_BUSHING_AGG_BATCH];
+} log_record_t;
+
+BL_OSAL_QUEUE_DEFINE(log_record_queue, BL_OSAL_QUEUE_BY_VALUE, RECORD_QUEUE_LENGTH,
+                     sizeof(log_record_t *));
+BL_OSAL_QUEUE_DEFINE(mqtt_record_queue, BL_OSAL_QUEUE_BY_VALUE, RECORD_QUEUE_LENGTH,
+                     sizeof(log_record_t *));
+
+/* Environmental averages, filled in place in a record of the queue by the
+ * aggregation task and published by the LTE/MQTT task
+ */
+typedef struct {
+    uint64_t timestamp;         /* Last snapshot, shared timebase us */
+    uint32_t snapshots;
+    float temperature_avg;
+    float temperature_max;
+    float humidity_avg;
+    float vibration_max;
+} env_report_t;
+
+BL_OSAL_QUEUE_DEFINE(env_report_queue, BL_OSAL_QUEUE_BY_REF, ENV_REPORT_QUEUE_LENGTH,
+                     sizeof(env_report_t));
+
+/* Alarm messages kept from the IPC handler for the alarm cloud task */
+BL_OSAL_QUEUE_DEFINE(alarm_msg_queue, BL_OSAL_QUEUE_BY_VALUE, ALARM_QUEUE_LENGTH,
+                     sizeof(bl_ipc_msg_t *));
+
+/* Publications of the LTE/MQTT task, logged every second */
+static struct {
+    uint32_t messages;
+    uint32_t bytes;
+    uint32_t truncated;
+} mqtt_stats;
+
 /* Task handles */
 static struct k_thread openamp_comm_thread;
 static struct k_thread modbus_thread;
@@ -125,45 +190,49 @@ K_THREAD_STACK_DEFINE(alarm_cloud_stack, ALARM_CLOUD_STACK_SIZE);
  * TASK IMPLEMENTATIONS
  * =============================================================================*/
 
+/**
+ * @brief Alarm status from M4
+ */
+static void ipc_alarm_status_handler(const bl_ipc_msg_t *msg, void *ctx)
+{
+    const bl_msg_alarm_status_t *status = bl_msg_alarm_status_decode(msg);
+    bl_ipc_msg_t *kept;
+
+    /* Process alarm status from M4 */
+    LOG_DBG("M4 alarms 0x%08x, severity %u", status->active_alarms, status->severity_level);
+
+    /* The alarm cloud task takes over the message */
+    kept = bl_ipc_msg_keep(msg);
+    if (kept && bl_osal_queue_send(&alarm_msg_queue, &kept, K_NO_WAIT) != 0) {
+        bl_osal_buf_unref(kept);
+    }
+}
+
+/**
+ * @brief System status from M4
+ */
+static void ipc_system_status_handler(const bl_ipc_msg_t *msg, void *ctx)
+{
+    /* Update system status */
+}
+
 /**
  * @brief OpenAMP Communication Task (M7)
  * Handles inter-core communication with M4
+ *
+ * Messages are dispatched as soon as they arrive; the task sleeps only
+ * while all receive queues are empty. Sensor data is not routed here, the
+ * aggregation tasks read it from the sensor mailbox.
  */
 static void openamp_comm_m7_task(void *p1, void *p2, void *p3)
 {
-    bl_ipc_msg_t msg;
-    int ret;
-
     LOG_INF("OpenAMP M7 task started");
 
-    while (1) {
-        /* Check for messages from M4 */
-        ret = bl_ipc_recv_msg(&msg, K_MSEC(OPENAMP_COMM_PERIOD));
-        if (ret == 0) {
-            LOG_DBG("Received message from M4: type=%d, len=%d",
-                    msg.msg_type, msg.data_len);
-
-            /* Process message based on type */
-            switch (msg.msg_type) {
-                case BL_MSG_TYPE_SENSOR_DATA:
-                    /* Forward sensor data to aggregation tasks */
-                    break;
-
-                case BL_MSG_TYPE_ALARM_STATUS:
-                    /* Process alarm status from M4 */
-                    break;
-
-                case BL_MSG_TYPE_SYSTEM_STATUS:
-                    /* Update system status */
-                    break;
-
-                default:
-                    LOG_WRN("Unknown message type: %d", msg.msg_type);
-                    break;
-            }
-        }
+    bl_ipc_register_handler(BL_MSG_TYPE_ALARM_STATUS, ipc_alarm_status_handler, NULL);
+    bl_ipc_register_handler(BL_MSG_TYPE_SYSTEM_STATUS, ipc_system_status_handler, NULL);
 
-        k_msleep(OPENAMP_COMM_PERIOD);
+    while (1) {
+        bl_ipc_dispatch(K_FOREVER);
     }
 }
 
@@ -173,14 +242,81 @@ static void openamp_comm_m7_task(void *p1, void *p2, void *p3)
  */
 static void modbus_task(void *p1, void *p2, void *p3)
 {
+    bl_osal_periodic_t periodic;
+
     LOG_INF("Modbus task started");
 
+    bl_osal_periodic_init(&periodic, MODBUS_POLL_PERIOD);
     while (1) {
         /* TODO: Implement Modbus polling logic */
         LOG_DBG("Modbus polling cycle");
 
-        k_msleep(MODBUS_POLL_PERIOD);
+        bl_osal_periodic_wait(&periodic);
+    }
+}
+
+/**
+ * @brief Publish one MQTT message
+ *
+ * There is no LTE modem driver yet: the publication is logged and counted.
+ */
+static void mqtt_publish(const char *topic, const char *payload, int len)
+{
+    if (len >= MQTT_PAYLOAD_MAX) {
+        mqtt_stats.truncated++;
+        len = MQTT_PAYLOAD_MAX - 1;
+    }
+
+    LOG_DBG("MQTT %s %.*s", topic, len, payload);
+    mqtt_stats.messages++;
+    mqtt_stats.bytes += (uint32_t)len;
+}
+
+/**
+ * @brief Publish an acquisition record: raw sample means and the processed values
+ */
+static void mqtt_publish_record(const log_record_t *record)
+{
+    char payload[MQTT_PAYLOAD_MAX];
+    uint32_t voltage = 0;
+    uint32_t current = 0;
+    uint32_t count = MAX(record->count, 1U);
+    int len;
+
+    for (uint32_t i = 0; i < record->count; i++) {
+        voltage += record->samples[i].voltage;
+        current += record->samples[i].current;
     }
+
+    len = snprintk(payload, sizeof(payload),
+                   "{\"ts\":%llu,\"n\":%u,\"v_raw\":%u,\"i_raw\":%u,"
+                   "\"f_mhz\":%d,\"u_mv\":%d,\"i_ma\":%d,\"synthetic\":%s}",
+                   (unsigned long long)record->samples[0].timestamp, record->count,
+                   voltage / count, current / count,
+                   (int)(record->sensor.frequency * 1000.0f),
+                   (int)(record->sensor.bushing_voltage * 1000.0f),
+                   (int)(record->sensor.bushing_current * 1000.0f),
+                   (record->samples[0].flags & BL_ADC_SAMPLE_SYNTHETIC) ? "true" : "false");
+    mqtt_publish(MQTT_TOPIC_SAMPLES, payload, len);
+}
+
+/**
+ * @brief Publish an environmental report
+ */
+static void mqtt_publish_env(const env_report_t *report)
+{
+    char payload[MQTT_PAYLOAD_MAX];
+    int len;
+
+    len = snprintk(payload, sizeof(payload),
+                   "{\"ts\":%llu,\"n\":%u,\"t_avg_mc\":%d,\"t_max_mc\":%d,"
+                   "\"rh_avg_pm\":%d,\"vib_max_mg\":%d}",
+                   (unsigned long long)report->timestamp, report->snapshots,
+                   (int)(report->temperature_avg * 1000.0f),
+                   (int)(report->temperature_max * 1000.0f),
+                   (int)(report->humidity_avg * 10.0f),
+                   (int)(report->vibration_max * 1000.0f));
+    mqtt_publish(MQTT_TOPIC_ENV, payload, len);
 }
 
 /**
@@ -189,13 +325,30 @@ static void modbus_task(void *p1, void *p2, void *p3)
  */
 static void lte_mqtt_task(void *p1, void *p2, void *p3)
 {
+    log_record_t *record;
+    env_report_t *report;
+    bl_osal_periodic_t periodic;
+
     LOG_INF("LTE/MQTT task started");
 
+    bl_osal_periodic_init(&periodic, LTE_MQTT_PERIOD);
     while (1) {
-        /* TODO: Implement LTE/MQTT logic */
+        /* TODO: Implement LTE modem management */
         LOG_DBG("LTE/MQTT processing");
 
-        k_msleep(LTE_MQTT_PERIOD);
+        /* Shared with the logging task: drop this task's reference */
+        while (bl_osal_queue_recv(&mqtt_record_queue, &record, K_NO_WAIT) == 0) {
+            mqtt_publish_record(record);
+            bl_osal_buf_unref(record);
+        }
+
+        /* Owned by this task once received: return it to the queue's pool */
+        while (bl_osal_queue_recv_ref(&env_report_queue, (void **)&report, K_NO_WAIT) == 0) {
+            mqtt_publish_env(report);
+            bl_osal_queue_free(&env_report_queue, report);
+        }
+
+        bl_osal_periodic_wait(&periodic);
     }
 }
 
@@ -205,13 +358,16 @@ static void lte_mqtt_task(void *p1, void *p2, void *p3)
  */
 static void iec61850_task(void *p1, void *p2, void *p3)
 {
+    bl_osal_periodic_t periodic;
+
     LOG_INF("IEC61850 task started");
 
+    bl_osal_periodic_init(&periodic, IEC61850_PERIOD);
     while (1) {
         /* TODO: Implement IEC61850 logic */
         LOG_DBG("IEC61850 processing");
 
-        k_msleep(IEC61850_PERIOD);
+        bl_osal_periodic_wait(&periodic);
     }
 }
 
@@ -221,13 +377,19 @@ static void iec61850_task(void *p1, void *p2, void *p3)
  */
 static void ai_analytics_task(void *p1, void *p2, void *p3)
 {
+    bl_osal_periodic_t periodic;
+
     LOG_INF("AI Analytics task started");
 
+    bl_osal_periodic_init(&periodic, AI_ANALYTICS_PERIOD);
     while (1) {
-        /* TODO: Implement AI analytics logic */
-        LOG_DBG("Running AI analytics");
+        /* Analytics is the first work given up when the core is overloaded */
+        if (!bl_osal_exec_is_shedding()) {
+            /* TODO: Implement AI analytics logic */
+            LOG_DBG("Running AI analytics");
+        }
 
-        k_msleep(AI_ANALYTICS_PERIOD);
+        bl_osal_periodic_wait(&periodic);
     }
 }
 
@@ -237,13 +399,26 @@ static void ai_analytics_task(void *p1, void *p2, void *p3)
  */
 static void fatfs_logging_task(void *p1, void *p2, void *p3)
 {
+    log_record_t *record;
+    bl_osal_periodic_t periodic;
+
     LOG_INF("FatFS logging task started");
 
+    bl_osal_periodic_init(&periodic, FATFS_LOGGING_PERIOD);
     while (1) {
-        /* TODO: Implement FatFS logging logic */
-        LOG_DBG("Logging data to SD card");
+        /* Records are still drained while shedding, so the aggregation
+         * task never runs out of them; logging is shed with the
+         * low-criticality rate groups
+         */
+        while (bl_osal_queue_recv(&log_record_queue, &record, K_NO_WAIT) == 0) {
+            if (!bl_osal_exec_is_shedding()) {
+                /* TODO: Implement FatFS logging logic */
+                LOG_DBG("Logging %u samples to SD card", record->count);
+            }
+            bl_osal_buf_unref(record);
+        }
 
-        k_msleep(FATFS_LOGGING_PERIOD);
+        bl_osal_periodic_wait(&periodic);
     }
 }
 
@@ -253,13 +428,16 @@ static void fatfs_logging_task(void *p1, void *p2, void *p3)
  */
 static void fota_manager_task(void *p1, void *p2, void *p3)
 {
+    bl_osal_periodic_t periodic;
+
     LOG_INF("FOTA Manager task started");
 
+    bl_osal_periodic_init(&periodic, FOTA_MANAGER_PERIOD);
     while (1) {
         /* TODO: Implement FOTA management logic */
         LOG_DBG("Checking for firmware updates");
 
-        k_msleep(FOTA_MANAGER_PERIOD);
+        bl_osal_periodic_wait(&periodic);
     }
 }
 
@@ -269,21 +447,63 @@ static void fota_manager_task(void *p1, void *p2, void *p3)
  */
 static void fan_supervisor_task(void *p1, void *p2, void *p3)
 {
+    bl_msg_fan_control_t cmd = {
+        .enabled = 1,
+        .speed_percent = 50,
+        .mode = 0,
+        .target_temperature = 25.0f,
+    };
     bl_ipc_msg_t msg;
+    int ret;
+    bl_osal_periodic_t periodic;
+
     LOG_INF("Fan Supervisor task started");
 
+    bl_osal_periodic_init(&periodic, FAN_SUPERVISOR_PERIOD);
     while (1) {
         /* TODO: Implement fan supervision logic */
         LOG_DBG("Fan supervision cycle");
 
         /* Example: Send fan control command to M4 */
-        msg.msg_type = BL_MSG_TYPE_FAN_CONTROL;
-        msg.data_len = sizeof(uint32_t);
-        /* Set fan control data */
+        bl_msg_fan_control_encode(&msg, &cmd);
+
+        ret = bl_ipc_send_msg(&msg);
+        if (ret != 0) {
+            LOG_WRN("Fan control command not sent: %d", ret);
+        }
+
+        bl_osal_periodic_wait(&periodic);
+    }
+}
+
+/**
+ * @brief Run a calibration sequence on M4
+ *
+ * Every step is sent before any response is awaited, so the sequence takes
+ * one round trip plus the M4 execution time rather than a round trip (or a
+ * polling period) per step.
+ */
+static void calib_run_sequence(void)
+{
+    bl_rpc_future_t steps[CALIB_CHANNELS];
+    bl_msg_calibration_t cmd = { .command = BL_CALIB_CMD_OFFSET };
+    bl_ipc_msg_t msg;
+    int ret;
 
-        bl_ipc_send_msg(&msg);
+    for (uint8_t ch = 0; ch < CALIB_CHANNELS; ch++) {
+        cmd.channel = ch;
+        bl_msg_calibration_encode(&msg, &cmd);
+        (void)bl_rpc_start(&steps[ch], &msg, K_MSEC(CALIB_RPC_TIMEOUT_MS));
+    }
 
-        k_msleep(FAN_SUPERVISOR_PERIOD);
+    for (uint8_t ch = 0; ch < CALIB_CHANNELS; ch++) {
+        ret = bl_rpc_wait(&steps[ch], K_FOREVER);
+        if (ret != 0) {
+            LOG_WRN("Calibration of channel %u failed: %d", ch, ret);
+        } else {
+            LOG_INF("Channel %u calibrated, M4 %u us, round trip %u us",
+                    ch, steps[ch].result.service_us, steps[ch].result.rtt_us);
+        }
     }
 }
 
@@ -299,7 +519,9 @@ static void calib_ui_task(void *p1, void *p2, void *p3)
         /* TODO: Implement calibration UI logic */
         LOG_DBG("Calibration UI processing");
 
-        k_msleep(CALIB_UI_PERIOD);
+        if (k_sem_take(&calib_request_sem, K_MSEC(CALIB_UI_PERIOD)) == 0) {
+            calib_run_sequence();
+        }
     }
 }
 
@@ -309,13 +531,53 @@ static void calib_ui_task(void *p1, void *p2, void *p3)
  */
 static void freq_bushing_agg_task(void *p1, void *p2, void *p3)
 {
+    log_record_t *record;
+    bl_sensor_data_t sensor = {0};
+    int count;
+    bl_osal_periodic_t periodic;
+
     LOG_INF("Freq/Bushing aggregation task started");
 
+    bl_osal_periodic_init(&periodic, FREQ_BUSHING_AGG_PERIOD);
     while (1) {
-        /* TODO: Implement data aggregation logic */
-        LOG_DBG("Aggregating frequency/bushing data");
+        /* Latest processed values from M4 */
+        if (bl_ipc_mailbox_read(BL_IPC_MAILBOX_SENSOR, &sensor, NULL) == 0) {
+            LOG_DBG("Freq: %.2f Hz, Voltage: %.1f V, Current: %.1f A",
+                    sensor.frequency, sensor.bushing_voltage, sensor.bushing_current);
+        }
 
-        k_msleep(FREQ_BUSHING_AGG_PERIOD);
+        /* Drain the raw sample stream from M4 straight into log records;
+         * samples stay in the stream while the logging task is behind
+         */
+        do {
+            record = bl_osal_buf_alloc(sizeof(*record), K_NO_WAIT);
+            if (!record) {
+                break;
+            }
+
+            count = bl_ipc_stream_read(BL_IPC_STREAM_ADC, record->samples,
+                                       ARRAY_SIZE(record->samples), K_NO_WAIT);
+            if (count > 0) {
+                /* TODO: Implement data aggregation logic */
+                LOG_DBG("Aggregating %d frequency/bushing samples", count);
+
+                record->sensor = sensor;
+                record->count = (uint32_t)count;
+
+                /* One reference for each consumer; a full queue drops its copy */
+                bl_osal_buf_ref(record);
+                if (bl_osal_queue_send(&log_record_queue, &record, K_NO_WAIT) != 0) {
+                    bl_osal_buf_unref(record);
+                }
+                if (bl_osal_queue_send(&mqtt_record_queue, &record, K_NO_WAIT) != 0) {
+                    bl_osal_buf_unref(record);
+                }
+            } else {
+                bl_osal_buf_unref(record);
+            }
+        } while (count == ARRAY_SIZE(record->samples));
+
+        bl_osal_periodic_wait(&periodic);
     }
 }
 
@@ -325,13 +587,53 @@ static void freq_bushing_agg_task(void *p1, void *p2, void *p3)
  */
 static void env_agg_task(void *p1, void *p2, void *p3)
 {
+    bl_sensor_data_t sensor;
+    env_report_t *report = NULL;
+    uint32_t seq;
+    uint32_t last_seq = 0;
+    bl_osal_periodic_t periodic;
+
     LOG_INF("Environmental aggregation task started");
 
+    bl_osal_periodic_init(&periodic, ENV_AGG_PERIOD);
     while (1) {
-        /* TODO: Implement environmental data aggregation */
-        LOG_DBG("Aggregating environmental data");
+        /* Only aggregate snapshots M4 has published since the last cycle */
+        if (bl_ipc_mailbox_read(BL_IPC_MAILBOX_SENSOR, &sensor, &seq) == 0 &&
+            seq != last_seq) {
+            last_seq = seq;
+
+            LOG_DBG("Aggregating environmental data: %.1f°C, %.1f%%, %.2f g",
+                    sensor.temperature, sensor.humidity, sensor.vibration);
+
+            /* The report is built in place in a record of the queue; while
+             * the LTE/MQTT task holds them all, snapshots are skipped
+             */
+            if (!report &&
+                bl_osal_queue_alloc(&env_report_queue, (void **)&report, K_NO_WAIT) == 0) {
+                memset(report, 0, sizeof(*report));
+                report->temperature_max = sensor.temperature;
+                report->vibration_max = sensor.vibration;
+            }
 
-        k_msleep(ENV_AGG_PERIOD);
+            if (report) {
+                report->timestamp = sensor.timestamp;
+                report->temperature_avg += sensor.temperature;
+                report->temperature_max = MAX(report->temperature_max, sensor.temperature);
+                report->humidity_avg += sensor.humidity;
+                report->vibration_max = MAX(report->vibration_max, sensor.vibration);
+
+                if (++report->snapshots == ENV_REPORT_SNAPSHOTS) {
+                    report->temperature_avg /= (float)report->snapshots;
+                    report->humidity_avg /= (float)report->snapshots;
+
+                    /* The pool holds as many records as the queue has entries */
+                    (void)bl_osal_queue_send_ref(&env_report_queue, report, K_NO_WAIT);
+                    report = NULL;
+                }
+            }
+        }
+
+        bl_osal_periodic_wait(&periodic);
     }
 }
 
@@ -341,13 +643,30 @@ static void env_agg_task(void *p1, void *p2, void *p3)
  */
 static void alarm_cloud_task(void *p1, void *p2, void *p3)
 {
+    bl_sensor_data_t sensor;
+    bl_ipc_msg_t *msg;
+    const bl_msg_alarm_status_t *status;
+    bl_osal_periodic_t periodic;
+
     LOG_INF("Alarm cloud task started");
 
+    bl_osal_periodic_init(&periodic, ALARM_CLOUD_PERIOD);
     while (1) {
         /* TODO: Implement cloud alarm logic */
-        LOG_DBG("Processing cloud alarms");
+        if (bl_ipc_mailbox_read(BL_IPC_MAILBOX_SENSOR, &sensor, NULL) == 0) {
+            LOG_DBG("Processing cloud alarms, sensor data %llu us old",
+                    (unsigned long long)(bl_osal_get_time_us() - sensor.timestamp));
+        }
+
+        /* Alarm messages received from M4 since the last cycle */
+        while (bl_osal_queue_recv(&alarm_msg_queue, &msg, K_NO_WAIT) == 0) {
+            status = bl_msg_alarm_status_decode(msg);
+            LOG_DBG("Cloud alarm 0x%08x, severity %u",
+                    status->active_alarms, status->severity_level);
+            bl_osal_buf_unref(msg);
+        }
 
-        k_msleep(ALARM_CLOUD_PERIOD);
+        bl_osal_periodic_wait(&periodic);
     }
 }
 
@@ -426,9 +745,22 @@ void bl_app_1000ms(uint32_t core_id)
 {
     /* 1s periodic processing - AI Analytics */
     static uint32_t seconds = 0;
+    bl_osal_queue_stats_t stats;
     seconds++;
 
     LOG_INF("M7 running for %u seconds", seconds);
+
+    if (bl_osal_queue_get_stats(&log_record_queue, &stats) == 0) {
+        LOG_INF("Log records - sent:%u, depth:%u, max:%u, full:%u",
+                stats.sent, stats.depth, stats.depth_max, stats.send_timeouts);
+    }
+    if (bl_osal_queue_get_stats(&env_report_queue, &stats) == 0) {
+        LOG_INF("Env reports - sent:%u, held:%u, max:%u, no record:%u",
+                stats.sent, stats.records, stats.records_max, stats.alloc_failures);
+    }
+
+    LOG_INF("MQTT - published:%u, bytes:%u, truncated:%u",
+            mqtt_stats.messages, mqtt_stats.bytes, mqtt_stats.truncated);
 }
 
 /* =============================================================================
@@ -457,6 +789,11 @@ static int create_m7_tasks(void)
 {
     LOG_INF("Creating M7 tasks");
 
+    bl_osal_queue_init(&log_record_queue);
+    bl_osal_queue_init(&mqtt_record_queue);
+    bl_osal_queue_init(&env_report_queue);
+    bl_osal_queue_init(&alarm_msg_queue);
+
     /* Create OpenAMP communication task */
     k_thread_create(&openamp_comm_thread,
                     openamp_comm_stack,
@@ -590,7 +927,7 @@ static int bl_isw_t_main_m7_init(void)
     LOG_INF("=== Transformer Gateway M7 Core Initialization ===");
 
     /* Initialize ISW for M7 */
-    bl_isw_init_m7();
+    bl_isw_init();
 
     /* Initialize M7 peripherals */
     ret = init_m7_peripherals();
@@ -24,5 +24,40 @@
 #define VRING_ALIGNMENT		4
 #define VRING_SIZE		16
 
+/* Shared data region, exchanged outside of the vrings. On native_sim it
+ * lives in the segment shared by the M7 and M4 processes (bl,ipc-host);
+ * single-image builds (loopback) use a local buffer.
+ */
+#if DT_NODE_EXISTS(DT_NODELABEL(shared_data))
+#define BL_SHARED_DATA_ADDR	DT_REG_ADDR(DT_NODELABEL(shared_data))
+#define BL_SHARED_DATA_SIZE	DT_REG_SIZE(DT_NODELABEL(shared_data))
+#elif DT_HAS_COMPAT_STATUS_OKAY(bl_ipc_host)
+extern void *bl_ipc_host_shared_data(void);
+#define BL_SHARED_DATA_ADDR	((uintptr_t)bl_ipc_host_shared_data())
+#define BL_SHARED_DATA_SIZE	DT_PROP(DT_COMPAT_GET_ANY_STATUS_OKAY(bl_ipc_host), shared_data_size)
+#else
+#define BL_SHARED_DATA_LOCAL
+extern uint8_t bl_shared_data[];
+#define BL_SHARED_DATA_ADDR	((uintptr_t)bl_shared_data)
+#define BL_SHARED_DATA_SIZE	0x10000
+#endif
+
+/* Areas of the shared data region, as offsets from BL_SHARED_DATA_ADDR.
+ * On native_sim the base is only known once the IPC instance is open, so
+ * the addresses are formed at run time.
+ */
+
+/* Sample stream rings (M4 -> M7) */
+#define BL_SHM_STREAM_ADC_OFFSET	0x0
+#define BL_SHM_STREAM_ADC_SIZE	0x4000
+
+/* IPC flow control credits and per-type counters (both cores) */
+#define BL_SHM_IPC_FLOW_OFFSET	(BL_SHM_STREAM_ADC_OFFSET + BL_SHM_STREAM_ADC_SIZE)
+#define BL_SHM_IPC_FLOW_SIZE	0x400
+
+/* Latest-value mailboxes (M4 -> M7) */
+#define BL_SHM_MAILBOX_SENSOR_OFFSET	(BL_SHM_IPC_FLOW_OFFSET + BL_SHM_IPC_FLOW_SIZE)
+#define BL_SHM_MAILBOX_SENSOR_SIZE	0x100
+
 
 #endif
@@ -0,0 +1,697 @@
+/****
+* File Name    : bl_ipc_host.c
+* Version      : 1.0.0
+* Description  : IPC service backend for native_sim. The M7 and M4 images run as
+*                two Linux processes that share a POSIX shared memory segment
+*                holding, per direction, a pool of buffers and two rings in the
+*                style of virtio: "avail" hands filled buffers to the receiver,
+*                "used" hands them back to the sender. Endpoints bind by name
+*                as with RPMsg, so bl_zephyr_osal_cfg.c runs unchanged.
+* Creation Date: Oct 2026
+****/
+
+#define DT_DRV_COMPAT bl_ipc_host
+
+/****
+ * Includes
+ ****/
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/ipc/ipc_service_backend.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/sys/barrier.h>
+#include <string.h>
+#include "bl_ipc_host_bottom.h"
+
+LOG_MODULE_REGISTER(bl_ipc_host, LOG_LEVEL_INF);
+
+BUILD_ASSERT(DT_NUM_INST_STATUS_OKAY(DT_DRV_COMPAT) <= 1,
+             "a single bl,ipc-host instance is supported");
+
+/****
+ * Macro definitions
+ ****/
+
+/* Marks the segment as initialised by the host side */
+#define BL_IPC_HOST_MAGIC           0x424C4850U   /* "BLHP" */
+
+#define BL_IPC_HOST_EPT_MAX         8U
+#define BL_IPC_HOST_NAME_LEN        32U
+#define BL_IPC_HOST_RING_MAX        64U
+#define BL_IPC_HOST_ALIGN           64U           /* Host cache line */
+#define BL_IPC_HOST_NO_EPT          0xFFU
+
+/* Sides of the link; a direction is identified by its sending side */
+#define BL_IPC_HOST_SIDE_HOST       0U
+#define BL_IPC_HOST_SIDE_REMOTE     1U
+
+/* Receive thread, delivers from cooperative context like the RPMsg work queue */
+#define BL_IPC_HOST_STACK_SIZE      2048
+#define BL_IPC_HOST_PRIORITY        K_PRIO_COOP(1)
+
+/* Remote side: period between attempts to attach to the segment */
+#define BL_IPC_HOST_ATTACH_MS       10
+
+/* Copying send waits for a buffer as long as rpmsg_send() does */
+#define BL_IPC_HOST_SEND_TIMEOUT    K_SECONDS(15)
+
+/* Receive buffer state */
+#define BL_IPC_HOST_RX_IN_CB        BIT(0)        /* Received callback running */
+#define BL_IPC_HOST_RX_HELD         BIT(1)        /* Held by the application */
+
+/****
+ * Typedef definitions
+ ****/
+
+/* Single-producer/single-consumer ring of buffer indices */
+typedef struct {
+    volatile uint32_t head;                        /* Written by the producer only */
+    uint8_t reserved0[BL_IPC_HOST_ALIGN - sizeof(uint32_t)];
+    volatile uint32_t tail;                        /* Written by the consumer only */
+    uint8_t reserved1[BL_IPC_HOST_ALIGN - sizeof(uint32_t)];
+    uint32_t entry[BL_IPC_HOST_RING_MAX];
+} bl_ipc_host_ring_t;
+
+/* Buffer header, the payload follows */
+typedef struct {
+    uint32_t ept;                                  /* Endpoint id on the sending side */
+    uint32_t len;
+    uint8_t data[];
+} bl_ipc_host_slot_t;
+
+/* Segment header; buffers of both directions and the shared data region follow */
+typedef struct {
+    volatile uint32_t magic;
+    int32_t host_pid;                              /* Run that created the segment */
+    uint32_t buf_size;
+    uint32_t buf_count;
+    uint32_t data_size;
+    volatile uint32_t ept_mask[2];                 /* Registered endpoints per side */
+    char ept_name[2][BL_IPC_HOST_EPT_MAX][BL_IPC_HOST_NAME_LEN];
+    bl_ipc_host_ring_t avail[2];                   /* Filled buffers, per sending side */
+    bl_ipc_host_ring_t used[2];                    /* Returned buffers, per sending side */
+} __aligned(BL_IPC_HOST_ALIGN) bl_ipc_host_shm_t;
+
+typedef struct {
+    const char *shm_name;
+    uint32_t side;
+    uint32_t buf_size;
+    uint32_t buf_count;
+    uint32_t data_size;
+    uint32_t poll_us;
+    k_thread_stack_t *stack;
+    size_t stack_size;
+} bl_ipc_host_cfg_t;
+
+typedef struct {
+    const struct ipc_ept_cfg *cfg;
+    uint32_t id;
+    bool bound;
+} bl_ipc_host_ept_t;
+
+typedef struct {
+    bl_ipc_host_shm_t *shm;
+    uint8_t *slots[2];
+    uint8_t *shared;
+    uint32_t stride;
+    uint32_t mask;
+    struct k_spinlock lock;
+    uint32_t tx_free[BL_IPC_HOST_RING_MAX];
+    uint32_t tx_free_count;
+    uint8_t rx_state[BL_IPC_HOST_RING_MAX];
+    bl_ipc_host_ept_t epts[BL_IPC_HOST_EPT_MAX];
+    uint8_t peer_map[BL_IPC_HOST_EPT_MAX];        /* Peer endpoint id -> local index */
+    struct k_thread thread;
+    bool opened;
+} bl_ipc_host_data_t;
+
+/****
+ * Static function prototypes
+ ****/
+static void bl_ipc_host_ring_push(bl_ipc_host_ring_t *ring, uint32_t mask, uint32_t idx);
+static bool bl_ipc_host_ring_pop(bl_ipc_host_ring_t *ring, uint32_t mask, uint32_t *idx);
+static int bl_ipc_host_slot_index(const struct device *dev, uint32_t side, const void *buf);
+static void bl_ipc_host_bind(const struct device *dev);
+static void bl_ipc_host_rx_thread(void *p1, void *p2, void *p3);
+
+/****
+ * Function implementations
+ ****/
+
+static inline uint32_t bl_ipc_host_peer(const bl_ipc_host_cfg_t *cfg)
+{
+    return cfg->side ^ 1U;
+}
+
+static inline bl_ipc_host_slot_t *bl_ipc_host_slot(bl_ipc_host_data_t *data, uint32_t side,
+                                                   uint32_t idx)
+{
+    return (bl_ipc_host_slot_t *)(data->slots[side] + (idx * data->stride));
+}
+
+/**
+ * @brief Publish a buffer index (producer; one producer per ring and process)
+ */
+static void bl_ipc_host_ring_push(bl_ipc_host_ring_t *ring, uint32_t mask, uint32_t idx)
+{
+    uint32_t head = ring->head;
+
+    ring->entry[head & mask] = idx;
+
+    /* Entry and buffer contents must be visible before the new head */
+    barrier_dmem_fence_full();
+    ring->head = head + 1U;
+}
+
+/**
+ * @brief Take a buffer index (consumer; one consumer per ring and process)
+ */
+static bool bl_ipc_host_ring_pop(bl_ipc_host_ring_t *ring, uint32_t mask, uint32_t *idx)
+{
+    uint32_t tail = ring->tail;
+
+    if (tail == ring->head) {
+        return false;
+    }
+
+    /* Do not read the entry ahead of the head that announced it */
+    barrier_dmem_fence_full();
+    *idx = ring->entry[tail & mask];
+    barrier_dmem_fence_full();
+    ring->tail = tail + 1U;
+
+    return true;
+}
+
+/**
+ * @brief Index of the buffer whose payload starts at buf, or -EINVAL
+ */
+static int bl_ipc_host_slot_index(const struct device *dev, uint32_t side, const void *buf)
+{
+    const bl_ipc_host_cfg_t *cfg = dev->config;
+    bl_ipc_host_data_t *data = dev->data;
+    uintptr_t base = (uintptr_t)data->slots[side] + offsetof(bl_ipc_host_slot_t, data);
+    uintptr_t off = (uintptr_t)buf - base;
+
+    if ((uintptr_t)buf < base || (off % data->stride) != 0U ||
+        (off / data->stride) >= cfg->buf_count) {
+        return -EINVAL;
+    }
+
+    return (int)(off / data->stride);
+}
+
+/**
+ * @brief Hand a received buffer back to the peer
+ */
+static void bl_ipc_host_rx_return(const struct device *dev, uint32_t idx)
+{
+    const bl_ipc_host_cfg_t *cfg = dev->config;
+    bl_ipc_host_data_t *data = dev->data;
+
+    bl_ipc_host_ring_push(&data->shm->used[bl_ipc_host_peer(cfg)], data->mask, idx);
+}
+
+/**
+ * @brief Bind local endpoints to peer endpoints registered under the same name
+ */
+static void bl_ipc_host_bind(const struct device *dev)
+{
+    const bl_ipc_host_cfg_t *cfg = dev->config;
+    bl_ipc_host_data_t *data = dev->data;
+    uint32_t peer = bl_ipc_host_peer(cfg);
+    uint32_t peer_mask = data->shm->ept_mask[peer];
+
+    /* Names are written before the mask bit that publishes them */
+    barrier_dmem_fence_full();
+
+    for (uint32_t i = 0; i < BL_IPC_HOST_EPT_MAX; i++) {
+        bl_ipc_host_ept_t *ept = &data->epts[i];
+
+        if (ept->cfg == NULL || ept->bound) {
+            continue;
+        }
+
+        for (uint32_t j = 0; j < BL_IPC_HOST_EPT_MAX; j++) {
+            if ((peer_mask & BIT(j)) == 0U ||
+                strncmp(data->shm->ept_name[peer][j], ept->cfg->name,
+                        BL_IPC_HOST_NAME_LEN) != 0) {
+                continue;
+            }
+
+            data->peer_map[j] = (uint8_t)i;
+            ept->bound = true;
+            if (ept->cfg->cb.bound) {
+                ept->cfg->cb.bound(ept->cfg->priv);
+            }
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Receive thread: bind endpoints and deliver buffers from the peer
+ *
+ * native_sim runs every Zephyr thread of a process on one host thread, so
+ * blocking it on a host primitive (futex, eventfd) would stall the whole
+ * image. The rings are polled on the simulated clock instead, which keeps
+ * simulated time and the host clock in step.
+ */
+static void bl_ipc_host_rx_thread(void *p1, void *p2, void *p3)
+{
+    const struct device *dev = p1;
+    const bl_ipc_host_cfg_t *cfg = dev->config;
+    bl_ipc_host_data_t *data = dev->data;
+    bl_ipc_host_ring_t *avail = &data->shm->avail[bl_ipc_host_peer(cfg)];
+    bl_ipc_host_slot_t *slot;
+    bl_ipc_host_ept_t *ept;
+    k_spinlock_key_t key;
+    uint32_t idx;
+    uint8_t local;
+
+    ARG_UNUSED(p2);
+    ARG_UNUSED(p3);
+
+    while (1) {
+        bl_ipc_host_bind(dev);
+
+        while (bl_ipc_host_ring_pop(avail, data->mask, &idx)) {
+            if (idx >= cfg->buf_count) {
+                LOG_ERR("Invalid buffer index %u from peer", idx);
+                continue;
+            }
+
+            slot = bl_ipc_host_slot(data, bl_ipc_host_peer(cfg), idx);
+            local = (slot->ept < BL_IPC_HOST_EPT_MAX) ? data->peer_map[slot->ept]
+                                                      : BL_IPC_HOST_NO_EPT;
+            if (local == BL_IPC_HOST_NO_EPT) {
+                /* The peer may have bound before this side polled its names */
+                bl_ipc_host_bind(dev);
+                local = (slot->ept < BL_IPC_HOST_EPT_MAX) ? data->peer_map[slot->ept]
+                                                          : BL_IPC_HOST_NO_EPT;
+            }
+
+            if (local == BL_IPC_HOST_NO_EPT || slot->len > cfg->buf_size) {
+                LOG_WRN("Dropping message for endpoint %u (%u bytes)", slot->ept, slot->len);
+                key = k_spin_lock(&data->lock);
+                bl_ipc_host_rx_return(dev, idx);
+                k_spin_unlock(&data->lock, key);
+                continue;
+            }
+
+            ept = &data->epts[local];
+
+            key = k_spin_lock(&data->lock);
+            data->rx_state[idx] = BL_IPC_HOST_RX_IN_CB;
+            k_spin_unlock(&data->lock, key);
+
+            if (ept->cfg->cb.received) {
+                ept->cfg->cb.received(slot->data, slot->len, ept->cfg->priv);
+            }
+
+            /* The buffer stays with the receiver if it was held and not yet released */
+            key = k_spin_lock(&data->lock);
+            data->rx_state[idx] &= ~BL_IPC_HOST_RX_IN_CB;
+            if ((data->rx_state[idx] & BL_IPC_HOST_RX_HELD) == 0U) {
+                bl_ipc_host_rx_return(dev, idx);
+            }
+            k_spin_unlock(&data->lock, key);
+        }
+
+        k_sleep(K_USEC(cfg->poll_us));
+    }
+}
+
+/**
+ * @brief Map the segment: the host side creates it, the remote side waits for it
+ */
+static int bl_ipc_host_open_instance(const struct device *dev)
+{
+    const bl_ipc_host_cfg_t *cfg = dev->config;
+    bl_ipc_host_data_t *data = dev->data;
+    size_t hdr_size = ROUND_UP(sizeof(bl_ipc_host_shm_t), BL_IPC_HOST_ALIGN);
+    bl_ipc_host_shm_t *shm;
+    size_t size;
+
+    if (data->opened) {
+        return -EALREADY;
+    }
+
+    data->stride = ROUND_UP(sizeof(bl_ipc_host_slot_t) + cfg->buf_size, BL_IPC_HOST_ALIGN);
+    data->mask = cfg->buf_count - 1U;
+    size = hdr_size + (2U * cfg->buf_count * data->stride) + cfg->data_size;
+
+    if (cfg->side == BL_IPC_HOST_SIDE_HOST) {
+        shm = bl_ipc_host_bottom_map(cfg->shm_name, size, 1);
+        if (shm == NULL) {
+            LOG_ERR("Failed to create shared memory %s", cfg->shm_name);
+            return -EIO;
+        }
+
+        /* A new object is zero filled: rings empty, no endpoint registered */
+        shm->buf_size = cfg->buf_size;
+        shm->buf_count = cfg->buf_count;
+        shm->data_size = cfg->data_size;
+        shm->host_pid = bl_ipc_host_bottom_pid();
+        barrier_dmem_fence_full();
+        shm->magic = BL_IPC_HOST_MAGIC;
+    } else {
+        LOG_INF("Waiting for the host side on %s", cfg->shm_name);
+
+        /* A segment left by a killed run still carries the magic: only
+         * attach to one whose host is running and that is still the object
+         * behind the name, the host replaces stale ones when it starts.
+         */
+        while (1) {
+            shm = bl_ipc_host_bottom_map(cfg->shm_name, size, 0);
+            if (shm != NULL) {
+                if (shm->magic == BL_IPC_HOST_MAGIC) {
+                    barrier_dmem_fence_full();
+                    if (bl_ipc_host_bottom_pid_alive(shm->host_pid) &&
+                        bl_ipc_host_bottom_is_current()) {
+                        break;
+                    }
+                }
+                bl_ipc_host_bottom_unmap(shm, size);
+            }
+            k_msleep(BL_IPC_HOST_ATTACH_MS);
+        }
+
+        if (shm->buf_size != cfg->buf_size || shm->buf_count != cfg->buf_count ||
+            shm->data_size != cfg->data_size) {
+            LOG_ERR("Shared memory layout differs from the host side");
+            return -EINVAL;
+        }
+    }
+
+    data->shm = shm;
+    data->slots[BL_IPC_HOST_SIDE_HOST] = (uint8_t *)shm + hdr_size;
+    data->slots[BL_IPC_HOST_SIDE_REMOTE] = data->slots[BL_IPC_HOST_SIDE_HOST] +
+                                           (cfg->buf_count * data->stride);
+    data->shared = data->slots[BL_IPC_HOST_SIDE_REMOTE] + (cfg->buf_count * data->stride);
+
+    for (uint32_t i = 0; i < cfg->buf_count; i++) {
+        data->tx_free[i] = i;
+    }
+    data->tx_free_count = cfg->buf_count;
+    memset(data->peer_map, BL_IPC_HOST_NO_EPT, sizeof(data->peer_map));
+
+    k_thread_create(&data->thread, cfg->stack, cfg->stack_size, bl_ipc_host_rx_thread,
+                    (void *)dev, NULL, NULL, BL_IPC_HOST_PRIORITY, 0, K_NO_WAIT);
+    k_thread_name_set(&data->thread, "bl_ipc_host");
+
+    data->opened = true;
+    return 0;
+}
+
+/**
+ * @brief Publish an endpoint name; it binds once the peer registers the same name
+ */
+static int bl_ipc_host_register_endpoint(const struct device *dev, void **token,
+                                         const struct ipc_ept_cfg *cfg)
+{
+    const bl_ipc_host_cfg_t *host_cfg = dev->config;
+    bl_ipc_host_data_t *data = dev->data;
+    k_spinlock_key_t key;
+    int ret = -ENOMEM;
+
+    if (!data->opened) {
+        return -EIO;
+    }
+    if (cfg->name == NULL || strlen(cfg->name) >= BL_IPC_HOST_NAME_LEN) {
+        return -EINVAL;
+    }
+
+    key = k_spin_lock(&data->lock);
+    for (uint32_t i = 0; i < BL_IPC_HOST_EPT_MAX; i++) {
+        if (data->epts[i].cfg != NULL) {
+            continue;
+        }
+
+        strncpy(data->shm->ept_name[host_cfg->side][i], cfg->name, BL_IPC_HOST_NAME_LEN);
+        data->epts[i].id = i;
+        data->epts[i].bound = false;
+        barrier_dmem_fence_full();
+        data->epts[i].cfg = cfg;
+        data->shm->ept_mask[host_cfg->side] |= BIT(i);
+
+        *token = &data->epts[i];
+        ret = 0;
+        break;
+    }
+    k_spin_unlock(&data->lock, key);
+
+    return ret;
+}
+
+static int bl_ipc_host_deregister_endpoint(const struct device *dev, void *token)
+{
+    const bl_ipc_host_cfg_t *cfg = dev->config;
+    bl_ipc_host_data_t *data = dev->data;
+    bl_ipc_host_ept_t *ept = token;
+    k_spinlock_key_t key;
+
+    key = k_spin_lock(&data->lock);
+    data->shm->ept_mask[cfg->side] &= ~BIT(ept->id);
+    ept->cfg = NULL;
+    ept->bound = false;
+    k_spin_unlock(&data->lock, key);
+
+    return 0;
+}
+
+static int bl_ipc_host_get_tx_buffer_size(const struct device *dev, void *token)
+{
+    const bl_ipc_host_cfg_t *cfg = dev->config;
+
+    ARG_UNUSED(token);
+
+    return (int)cfg->buf_size;
+}
+
+/**
+ * @brief Borrow a transmit buffer, collecting the ones the peer has returned
+ */
+static int bl_ipc_host_get_tx_buffer(const struct device *dev, void *token,
+                                     void **buf, uint32_t *len, k_timeout_t wait)
+{
+    const bl_ipc_host_cfg_t *cfg = dev->config;
+    bl_ipc_host_data_t *data = dev->data;
+    bl_ipc_host_ring_t *used = &data->shm->used[cfg->side];
+    k_timepoint_t end = sys_timepoint_calc(wait);
+    k_spinlock_key_t key;
+    uint32_t idx;
+
+    ARG_UNUSED(token);
+
+    if (*len > cfg->buf_size) {
+        *len = cfg->buf_size;
+        return -ENOMEM;
+    }
+
+    while (1) {
+        key = k_spin_lock(&data->lock);
+        while (data->tx_free_count < cfg->buf_count &&
+               bl_ipc_host_ring_pop(used, data->mask, &idx)) {
+            if (idx < cfg->buf_count) {
+                data->tx_free[data->tx_free_count++] = idx;
+            }
+        }
+
+        if (data->tx_free_count > 0U) {
+            idx = data->tx_free[--data->tx_free_count];
+            k_spin_unlock(&data->lock, key);
+
+            *buf = bl_ipc_host_slot(data, cfg->side, idx)->data;
+            *len = cfg->buf_size;
+            return 0;
+        }
+        k_spin_unlock(&data->lock, key);
+
+        if (K_TIMEOUT_EQ(wait, K_NO_WAIT) || sys_timepoint_expired(end)) {
+            return -ENOBUFS;
+        }
+        k_sleep(K_USEC(cfg->poll_us));
+    }
+}
+
+static int bl_ipc_host_drop_tx_buffer(const struct device *dev, void *token, const void *buf)
+{
+    const bl_ipc_host_cfg_t *cfg = dev->config;
+    bl_ipc_host_data_t *data = dev->data;
+    k_spinlock_key_t key;
+    int idx;
+
+    ARG_UNUSED(token);
+
+    idx = bl_ipc_host_slot_index(dev, cfg->side, buf);
+    if (idx < 0) {
+        return idx;
+    }
+
+    key = k_spin_lock(&data->lock);
+    if (data->tx_free_count < cfg->buf_count) {
+        data->tx_free[data->tx_free_count++] = (uint32_t)idx;
+    }
+    k_spin_unlock(&data->lock, key);
+
+    return 0;
+}
+
+/**
+ * @brief Hand a borrowed buffer to the peer
+ */
+static int bl_ipc_host_send_nocopy(const struct device *dev, void *token,
+                                   const void *buf, size_t len)
+{
+    const bl_ipc_host_cfg_t *cfg = dev->config;
+    bl_ipc_host_data_t *data = dev->data;
+    bl_ipc_host_ept_t *ept = token;
+    bl_ipc_host_slot_t *slot;
+    k_spinlock_key_t key;
+    int idx;
+
+    if (!ept->bound) {
+        return -EBUSY;
+    }
+    if (len > cfg->buf_size) {
+        return -EBADMSG;
+    }
+
+    idx = bl_ipc_host_slot_index(dev, cfg->side, buf);
+    if (idx < 0) {
+        return idx;
+    }
+
+    slot = bl_ipc_host_slot(data, cfg->side, (uint32_t)idx);
+    slot->ept = ept->id;
+    slot->len = (uint32_t)len;
+
+    key = k_spin_lock(&data->lock);
+    bl_ipc_host_ring_push(&data->shm->avail[cfg->side], data->mask, (uint32_t)idx);
+    k_spin_unlock(&data->lock, key);
+
+    return (int)len;
+}
+
+static int bl_ipc_host_send(const struct device *dev, void *token, const void *msg, size_t len)
+{
+    uint32_t size = (uint32_t)len;
+    void *buf;
+    int ret;
+
+    ret = bl_ipc_host_get_tx_buffer(dev, token, &buf, &size, BL_IPC_HOST_SEND_TIMEOUT);
+    if (ret < 0) {
+        return ret;
+    }
+
+    memcpy(buf, msg, len);
+
+    ret = bl_ipc_host_send_nocopy(dev, token, buf, len);
+    if (ret < 0) {
+        bl_ipc_host_drop_tx_buffer(dev, token, buf);
+    }
+
+    return ret;
+}
+
+static int bl_ipc_host_hold_rx_buffer(const struct device *dev, void *token, void *buf)
+{
+    const bl_ipc_host_cfg_t *cfg = dev->config;
+    bl_ipc_host_data_t *data = dev->data;
+    k_spinlock_key_t key;
+    int idx;
+
+    ARG_UNUSED(token);
+
+    idx = bl_ipc_host_slot_index(dev, bl_ipc_host_peer(cfg), buf);
+    if (idx < 0) {
+        return idx;
+    }
+
+    key = k_spin_lock(&data->lock);
+    data->rx_state[idx] |= BL_IPC_HOST_RX_HELD;
+    k_spin_unlock(&data->lock, key);
+
+    return 0;
+}
+
+static int bl_ipc_host_release_rx_buffer(const struct device *dev, void *token, void *buf)
+{
+    const bl_ipc_host_cfg_t *cfg = dev->config;
+    bl_ipc_host_data_t *data = dev->data;
+    k_spinlock_key_t key;
+    int idx;
+
+    ARG_UNUSED(token);
+
+    idx = bl_ipc_host_slot_index(dev, bl_ipc_host_peer(cfg), buf);
+    if (idx < 0) {
+        return idx;
+    }
+
+    key = k_spin_lock(&data->lock);
+    if ((data->rx_state[idx] & BL_IPC_HOST_RX_HELD) == 0U) {
+        k_spin_unlock(&data->lock, key);
+        return -EALREADY;
+    }
+
+    /* Still inside the callback: the receive thread returns it on exit */
+    data->rx_state[idx] &= ~BL_IPC_HOST_RX_HELD;
+    if ((data->rx_state[idx] & BL_IPC_HOST_RX_IN_CB) == 0U) {
+        bl_ipc_host_rx_return(dev, (uint32_t)idx);
+    }
+    k_spin_unlock(&data->lock, key);
+
+    return 0;
+}
+
+static const struct ipc_service_backend bl_ipc_host_ops = {
+    .open_instance = bl_ipc_host_open_instance,
+    .send = bl_ipc_host_send,
+    .register_endpoint = bl_ipc_host_register_endpoint,
+    .deregister_endpoint = bl_ipc_host_deregister_endpoint,
+    .get_tx_buffer_size = bl_ipc_host_get_tx_buffer_size,
+    .get_tx_buffer = bl_ipc_host_get_tx_buffer,
+    .drop_tx_buffer = bl_ipc_host_drop_tx_buffer,
+    .send_nocopy = bl_ipc_host_send_nocopy,
+    .hold_rx_buffer = bl_ipc_host_hold_rx_buffer,
+    .release_rx_buffer = bl_ipc_host_release_rx_buffer,
+};
+
+#define BL_IPC_HOST_DEFINE(i)                                                       \
+    BUILD_ASSERT(IS_POWER_OF_TWO(DT_INST_PROP(i, buffer_count)) &&                  \
+                 DT_INST_PROP(i, buffer_count) <= BL_IPC_HOST_RING_MAX,             \
+                 "buffer-count must be a power of two up to 64");                   \
+    K_THREAD_STACK_DEFINE(bl_ipc_host_stack_##i, BL_IPC_HOST_STACK_SIZE);           \
+    static const bl_ipc_host_cfg_t bl_ipc_host_cfg_##i = {                          \
+        .shm_name = DT_INST_PROP(i, shm_name),                                      \
+        .side = DT_INST_ENUM_IDX(i, role),                                          \
+        .buf_size = DT_INST_PROP(i, buffer_size),                                   \
+        .buf_count = DT_INST_PROP(i, buffer_count),                                 \
+        .data_size = DT_INST_PROP(i, shared_data_size),                             \
+        .poll_us = DT_INST_PROP(i, poll_interval_us),                               \
+        .stack = bl_ipc_host_stack_##i,                                             \
+        .stack_size = K_THREAD_STACK_SIZEOF(bl_ipc_host_stack_##i),                 \
+    };                                                                              \
+    static bl_ipc_host_data_t bl_ipc_host_data_##i;                                 \
+    DEVICE_DT_INST_DEFINE(i, NULL, NULL, &bl_ipc_host_data_##i, &bl_ipc_host_cfg_##i, \
+                          POST_KERNEL, CONFIG_IPC_SERVICE_REG_BACKEND_PRIORITY,     \
+                          &bl_ipc_host_ops);
+
+DT_INST_FOREACH_STATUS_OKAY(BL_IPC_HOST_DEFINE)
+
+#if DT_NUM_INST_STATUS_OKAY(DT_DRV_COMPAT) > 0
+/**
+ * @brief Shared data region of the segment (BL_SHARED_DATA_ADDR on native_sim)
+ *
+ * Valid once the instance has been opened by bl_osal_ipc_init().
+ */
+void *bl_ipc_host_shared_data(void)
+{
+    const struct device *dev = DEVICE_DT_INST_GET(0);
+    bl_ipc_host_data_t *data = dev->data;
+
+    return data->shared;
+}
+#endif
@@ -0,0 +1,137 @@
+/****
+* File Name    : bl_ipc_host_bottom.c
+* Version      : 1.0.0
+* Description  : Host (Linux) side of the native_sim IPC backend: POSIX shared
+*                memory shared by the M7 and M4 processes.
+* Creation Date: Oct 2026
+****/
+
+/****
+ * Includes
+ ****/
+#include "bl_ipc_host_bottom.h"
+#include <fcntl.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/****
+ * Static variables
+ ****/
+static char bl_ipc_host_path[64];
+static dev_t bl_ipc_host_dev;
+static ino_t bl_ipc_host_ino;
+
+/****
+ * Function implementations
+ ****/
+
+/**
+ * @brief Remove the object on exit of the creating process
+ */
+static void bl_ipc_host_bottom_unlink(void)
+{
+    shm_unlink(bl_ipc_host_path);
+}
+
+/**
+ * @brief Map the shared memory object, creating it on the host side
+ */
+void *bl_ipc_host_bottom_map(const char *name, size_t size, int create)
+{
+    const char *env = getenv("BL_IPC_SHM");
+    struct stat st;
+    void *mem;
+    int fd;
+
+    snprintf(bl_ipc_host_path, sizeof(bl_ipc_host_path), "/%s", env ? env : name);
+
+    if (create) {
+        /* A previous run may have been killed before unlinking */
+        shm_unlink(bl_ipc_host_path);
+
+        fd = shm_open(bl_ipc_host_path, O_RDWR | O_CREAT | O_EXCL, 0600);
+        if (fd < 0) {
+            return NULL;
+        }
+        if (ftruncate(fd, (off_t)size) != 0) {
+            close(fd);
+            shm_unlink(bl_ipc_host_path);
+            return NULL;
+        }
+        atexit(bl_ipc_host_bottom_unlink);
+    } else {
+        fd = shm_open(bl_ipc_host_path, O_RDWR, 0);
+        if (fd < 0) {
+            return NULL;
+        }
+        /* Not sized yet, or sized by a build with another layout */
+        if (fstat(fd, &st) != 0 || (size_t)st.st_size != size) {
+            close(fd);
+            return NULL;
+        }
+    }
+
+    /* Identity of the object mapped, checked by bl_ipc_host_bottom_is_current() */
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return NULL;
+    }
+    bl_ipc_host_dev = st.st_dev;
+    bl_ipc_host_ino = st.st_ino;
+
+    mem = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+
+    return (mem == MAP_FAILED) ? NULL : mem;
+}
+
+/**
+ * @brief Unmap an object mapped with bl_ipc_host_bottom_map()
+ */
+void bl_ipc_host_bottom_unmap(void *mem, size_t size)
+{
+    munmap(mem, size);
+}
+
+/**
+ * @brief Check that the object mapped is still the one behind the name
+ *
+ * False once the host side replaced it, or when it was unlinked.
+ */
+int bl_ipc_host_bottom_is_current(void)
+{
+    struct stat st;
+    int fd;
+    int ret;
+
+    fd = shm_open(bl_ipc_host_path, O_RDONLY, 0);
+    if (fd < 0) {
+        return 0;
+    }
+
+    ret = (fstat(fd, &st) == 0) && (st.st_dev == bl_ipc_host_dev) &&
+          (st.st_ino == bl_ipc_host_ino);
+    close(fd);
+
+    return ret;
+}
+
+/**
+ * @brief Process id of this process, recorded by the host side in the segment
+ */
+int bl_ipc_host_bottom_pid(void)
+{
+    return (int)getpid();
+}
+
+/**
+ * @brief Check that a process is still running
+ */
+int bl_ipc_host_bottom_pid_alive(int pid)
+{
+    return (pid > 0) && (kill((pid_t)pid, 0) == 0);
+}
@@ -0,0 +1,29 @@
+/****
+* File Name    : bl_ipc_host_bottom.h
+* Version      : 1.0.0
+* Description  : Host (Linux) side of the native_sim IPC backend. Built into the
+*                native simulator runner, called from bl_ipc_host.c.
+* Creation Date: Oct 2026
+****/
+#ifndef BL_IPC_HOST_BOTTOM_H_
+#define BL_IPC_HOST_BOTTOM_H_
+
+#include <stddef.h>
+
+/* Map the shared memory object 'name'.
+ * create != 0: replace any stale object by a new one of 'size' bytes.
+ * create == 0: attach to an existing object; NULL until it has been created.
+ */
+void *bl_ipc_host_bottom_map(const char *name, size_t size, int create);
+
+/* Unmap an object mapped with bl_ipc_host_bottom_map() */
+void bl_ipc_host_bottom_unmap(void *mem, size_t size);
+
+/* Nonzero while the object mapped last is still the one behind its name */
+int bl_ipc_host_bottom_is_current(void);
+
+/* Process id of the caller, and whether process 'pid' is still running */
+int bl_ipc_host_bottom_pid(void);
+int bl_ipc_host_bottom_pid_alive(int pid);
+
+#endif /* BL_IPC_HOST_BOTTOM_H_ */
@@ -0,0 +1,140 @@
+/****
+* File Name    : bl_ipc_mailbox.c
+* Version      : 1.0.0
+* Description  : Sequence-locked "latest value" mailbox in shared memory.
+*                The writer never waits for readers and readers never block
+*                the writer; a reader simply retries if the value changed
+*                while it was being copied.
+* Creation Date: Oct 2026
+****/
+
+/****
+ * Includes
+ ****/
+#include "bl_ipc_mailbox.h"
+#include <zephyr/cache.h>
+#include <zephyr/sys/barrier.h>
+#include <string.h>
+
+/****
+ * Function implementations
+ ****/
+
+/**
+ * @brief Initialize a mailbox over a cache-line aligned memory area
+ *
+ * The reader creates the mailbox (create = true). The writer attaches to
+ * an existing mailbox and fails with -EAGAIN until it has been created.
+ */
+int bl_mailbox_init(bl_mailbox_t *mailbox, void *mem, size_t mem_size,
+                    uint32_t size, bool create)
+{
+    bl_mailbox_shm_t *shm = (bl_mailbox_shm_t *)mem;
+
+    if (!mailbox || !mem || size == 0 ||
+        ((uintptr_t)mem % BL_CACHE_LINE_SIZE) != 0 ||
+        mem_size < (sizeof(bl_mailbox_shm_t) + size)) {
+        return -EINVAL;
+    }
+
+    memset(mailbox, 0, sizeof(*mailbox));
+
+    if (create) {
+        shm->magic = 0;
+        shm->seq = 0;
+        shm->size = size;
+        memset(shm->data, 0, size);
+        sys_cache_data_flush_range(shm->data, size);
+        barrier_dmem_fence_full();
+        shm->magic = BL_MAILBOX_MAGIC;
+        sys_cache_data_flush_range(shm, sizeof(bl_mailbox_shm_t));
+    } else {
+        sys_cache_data_invd_range(shm, sizeof(bl_mailbox_shm_t));
+        if (shm->magic != BL_MAILBOX_MAGIC) {
+            return -EAGAIN;
+        }
+        if (shm->size != size) {
+            return -EINVAL;
+        }
+        mailbox->seq = shm->seq;
+    }
+
+    mailbox->shm = shm;
+    mailbox->size = size;
+
+    return 0;
+}
+
+/**
+ * @brief Replace the mailbox value (writer)
+ */
+void bl_mailbox_publish(bl_mailbox_t *mailbox, const void *data)
+{
+    bl_mailbox_shm_t *shm;
+
+    if (!mailbox || !mailbox->shm || !data) {
+        return;
+    }
+
+    shm = mailbox->shm;
+
+    /* Odd sequence: readers discard whatever they copy from now on */
+    shm->seq = ++mailbox->seq;
+    sys_cache_data_flush_range((void *)&shm->seq, sizeof(shm->seq));
+    barrier_dmem_fence_full();
+
+    memcpy(shm->data, data, mailbox->size);
+    sys_cache_data_flush_range(shm->data, mailbox->size);
+
+    /* Even sequence: the new value is complete */
+    barrier_dmem_fence_full();
+    shm->seq = ++mailbox->seq;
+    sys_cache_data_flush_range((void *)&shm->seq, sizeof(shm->seq));
+}
+
+/**
+ * @brief Copy a consistent snapshot of the mailbox value (reader)
+ * @param seq Optional, receives the sequence number of the snapshot; it
+ *            advances by 2 per publication, so readers can detect updates
+ * @return 0 on success, -ENODATA if nothing was published yet, -EBUSY if
+ *         the writer kept updating for BL_MAILBOX_READ_RETRIES attempts
+ */
+int bl_mailbox_read(bl_mailbox_t *mailbox, void *data, uint32_t *seq)
+{
+    bl_mailbox_shm_t *shm;
+    uint32_t before, after;
+
+    if (!mailbox || !mailbox->shm || !data) {
+        return -EINVAL;
+    }
+
+    shm = mailbox->shm;
+
+    for (uint32_t i = 0; i < BL_MAILBOX_READ_RETRIES; i++) {
+        sys_cache_data_invd_range((void *)&shm->seq, sizeof(shm->seq));
+        before = shm->seq;
+        if (before == 0) {
+            return -ENODATA;
+        }
+        if (before & 1U) {
+            continue;
+        }
+
+        /* The copy must not be started before seq has been read */
+        barrier_dmem_fence_full();
+        sys_cache_data_invd_range(shm->data, mailbox->size);
+        memcpy(data, shm->data, mailbox->size);
+        barrier_dmem_fence_full();
+
+        sys_cache_data_invd_range((void *)&shm->seq, sizeof(shm->seq));
+        after = shm->seq;
+        if (after == before) {
+            if (seq) {
+                *seq = before;
+            }
+            return 0;
+        }
+    }
+
+    return -EBUSY;
+}
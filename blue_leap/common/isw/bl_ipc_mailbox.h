@@ -0,0 +1,66 @@
+/****
+* File Name    : bl_ipc_mailbox.h
+* Version      : 1.0.0
+* Description  : Sequence-locked "latest value" mailbox in shared memory.
+* Creation Date: Oct 2026
+****/
+#ifndef BL_IPC_MAILBOX_H_
+#define BL_IPC_MAILBOX_H_
+
+/****
+ * Includes
+ ****/
+#include <zephyr/kernel.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "bl_ipc_stream.h"
+
+/****
+ * Macro definitions
+ ****/
+
+/* Marks a mailbox as initialised by the reader */
+#define BL_MAILBOX_MAGIC            0x424C4D42U   /* "BLMB" */
+
+/* Attempts a reader makes before giving up on a mailbox being rewritten */
+#define BL_MAILBOX_READ_RETRIES     16U
+
+/****
+ * Typedef definitions
+ ****/
+
+/* Mailbox as laid out in shared memory.
+ * seq is odd while the writer is updating data and even otherwise; a reader
+ * that sees the same even value before and after copying has a consistent
+ * snapshot. data starts on its own cache line.
+ */
+typedef struct {
+    volatile uint32_t seq;
+    uint32_t magic;
+    uint32_t size;
+    uint8_t reserved[BL_CACHE_LINE_SIZE - (3U * sizeof(uint32_t))];
+    uint8_t data[];
+} __aligned(BL_CACHE_LINE_SIZE) bl_mailbox_shm_t;
+
+/* Per-core mailbox handle (local memory) */
+typedef struct {
+    bl_mailbox_shm_t *shm;
+    uint32_t size;
+    uint32_t seq;          /* Writer: own sequence number */
+} bl_mailbox_t;
+
+/****
+ * Global functions
+ ****/
+
+/* Set up a mailbox over mem; the reader creates it, the writer attaches */
+extern int bl_mailbox_init(bl_mailbox_t *mailbox, void *mem, size_t mem_size,
+                           uint32_t size, bool create);
+
+/* Writer side (a single writer, or writers serialised by the caller) */
+extern void bl_mailbox_publish(bl_mailbox_t *mailbox, const void *data);
+
+/* Reader side (any number of readers) */
+extern int bl_mailbox_read(bl_mailbox_t *mailbox, void *data, uint32_t *seq);
+
+#endif /* BL_IPC_MAILBOX_H_ */
@@ -0,0 +1,169 @@
+/****
+* File Name    : bl_ipc_msg_def.h
+* Version      : 1.0.0
+* Description  : Inter-core message registry. Single definition of every message type
+*                exchanged between M7 and M4: its payload layout, lane and flow policy.
+*                Message type enum, payload structs, codecs and the IPC dispatch tables
+*                are all generated from the tables below, on both cores.
+* Creation Date: Oct 2026
+****/
+#ifndef bl_ipc_msg_def_H_
+#define bl_ipc_msg_def_H_
+
+/****
+ * Includes
+ ****/
+#include <zephyr/toolchain.h>
+#include <stdint.h>
+#include "bl_zephyr_osal_cfg.h"
+
+/****
+ * Payload definitions
+ ****/
+
+/* Fields of each fixed-size payload, in wire order: F(type, name).
+ * Payloads are packed and use fixed-width types only, so the layout is the
+ * same on M7 and M4 whatever the compiler options of each image.
+ */
+#define BL_MSG_SENSOR_DATA_FIELDS(F) \
+    F(uint64_t, timestamp)          /* Shared timebase, us */ \
+    F(float,    frequency) \
+    F(float,    bushing_voltage) \
+    F(float,    bushing_current) \
+    F(float,    temperature) \
+    F(float,    humidity) \
+    F(float,    vibration)
+
+#define BL_MSG_FAN_CONTROL_FIELDS(F) \
+    F(uint8_t,  enabled) \
+    F(uint8_t,  speed_percent) \
+    F(uint8_t,  mode)               /* 0: Auto, 1: Manual */ \
+    F(uint8_t,  reserved) \
+    F(float,    target_temperature)
+
+#define BL_MSG_CALIBRATION_FIELDS(F) \
+    F(uint8_t,  channel) \
+    F(uint8_t,  command)            /* BL_CALIB_CMD_* */ \
+    F(uint16_t, reserved) \
+    F(float,    reference)          /* Expected reading, ADC counts */
+
+#define BL_MSG_ALARM_STATUS_FIELDS(F) \
+    F(uint32_t, active_alarms) \
+    F(uint32_t, alarm_history) \
+    F(uint8_t,  severity_level)
+
+#define BL_MSG_SYSTEM_STATUS_FIELDS(F) \
+    F(uint8_t,  system_initialized) \
+    F(uint8_t,  core_sync_complete) \
+    F(uint16_t, reserved) \
+    F(uint32_t, task_status)
+
+/* Response to an RPC request, correlated by the rpc_id of the header */
+#define BL_MSG_RPC_RESPONSE_FIELDS(F) \
+    F(int32_t,  status)             /* Result of the request, negative errno on failure */ \
+    F(uint16_t, request_type) \
+    F(uint16_t, reserved) \
+    F(uint32_t, service_us)         /* Request sent to response sent, shared timebase */
+
+/* Clock offset exchange, handled by the IPC layer. M4 sends t1; M7 fills in
+ * t2 (request received) and t3 (reply sent). Times are local to each core.
+ */
+#define BL_MSG_TIME_SYNC_FIELDS(F) \
+    F(uint32_t, seq) \
+    F(uint32_t, reserved) \
+    F(uint64_t, t1) \
+    F(uint64_t, t2) \
+    F(uint64_t, t3)
+
+/* Execution profile request of one rate group (BL_OS_THREAD_*_ID) of the peer */
+#define BL_MSG_PROF_QUERY_FIELDS(F) \
+    F(uint8_t,  thread_id) \
+    F(uint8_t,  reserved) \
+    F(uint16_t, reserved2)
+
+/* Execution profile of one rate group, sent before the RPC response to a
+ * PROF_QUERY. Times are in cycles of the sender's profiling counter.
+ */
+#define BL_MSG_PROF_REPORT_FIELDS(F) \
+    F(uint8_t,  thread_id) \
+    F(uint8_t,  reserved) \
+    F(uint16_t, reserved2) \
+    F(uint32_t, cycle_rate)         /* Profiling counter frequency, Hz */ \
+    F(uint32_t, count) \
+    F(uint32_t, exec_min) \
+    F(uint32_t, exec_max) \
+    F(uint32_t, jitter_max) \
+    F(uint64_t, exec_total) \
+    F(uint64_t, jitter_total) \
+    F(uint32_t, exec_hist[BL_PROF_HIST_BINS]) \
+    F(uint32_t, jitter_hist[BL_PROF_HIST_BINS])
+
+/* Stack usage request of the index-th thread tracked by the peer */
+#define BL_MSG_STACK_QUERY_FIELDS(F) \
+    F(uint8_t,  index) \
+    F(uint8_t,  reserved) \
+    F(uint16_t, reserved2)
+
+/* Stack usage of one thread, sent before the RPC response to a STACK_QUERY */
+#define BL_MSG_STACK_REPORT_FIELDS(F) \
+    F(uint8_t,  index) \
+    F(uint8_t,  count)              /* Threads tracked by the sender */ \
+    F(uint16_t, reserved) \
+    F(uint32_t, size) \
+    F(uint32_t, peak) \
+    F(char,     name[BL_OS_STACK_NAME_LEN])
+
+/* Calibration commands */
+#define BL_CALIB_CMD_OFFSET     1U  /* Zero-offset calibration against the reference */
+#define BL_CALIB_CMD_GAIN       2U  /* Gain calibration against the reference */
+
+/****
+ * Message tables
+ ****/
+
+/* Fixed-size messages: X(NAME, name, lane, policy, size)
+ *   NAME/name  BL_MSG_TYPE_<NAME>, payload bl_msg_<name>_t
+ *   lane       BL_IPC_LANE_<lane>
+ *   policy     BL_IPC_FLOW_<policy> when the peer has no free RX slot
+ *   size       Payload size on the wire; checked at build time so that a
+ *              layout change cannot go unnoticed between the two images
+ * The enum values are the wire identifiers: both images must be built from
+ * the same tables.
+ */
+#define BL_IPC_MSG_TABLE(X) \
+    X(SENSOR_DATA,   sensor_data,   BULK,    DROP,  32) \
+    X(FAN_CONTROL,   fan_control,   CONTROL, BLOCK, 8) \
+    X(CALIBRATION,   calibration,   CONTROL, BLOCK, 8) \
+    X(ALARM_STATUS,  alarm_status,  ALARM,   BLOCK, 9) \
+    X(SYSTEM_STATUS, system_status, CONTROL, BLOCK, 8) \
+    X(TIME_SYNC,     time_sync,     CONTROL, DROP,  32) \
+    X(RPC_RESPONSE,  rpc_response,  CONTROL, BLOCK, 12) \
+    X(PROF_QUERY,    prof_query,    CONTROL, BLOCK, 4) \
+    X(PROF_REPORT,   prof_report,   CONTROL, BLOCK, 40 + 8 * BL_PROF_HIST_BINS) \
+    X(STACK_QUERY,   stack_query,   CONTROL, BLOCK, 4) \
+    X(STACK_REPORT,  stack_report,  CONTROL, BLOCK, 12 + BL_OS_STACK_NAME_LEN)
+
+/* Variable-size messages carrying up to BL_IPC_MSG_MAX_SIZE opaque bytes:
+ * X(NAME, name, lane, policy). Used by diagnostics and benchmarks, one per
+ * lane so that each lane can be exercised.
+ */
+#define BL_IPC_MSG_RAW_TABLE(X) \
+    X(DIAG_REQUEST,  diag_request,  CONTROL, BLOCK) \
+    X(DIAG_REPLY,    diag_reply,    ALARM,   BLOCK) \
+    X(DIAG_BULK,     diag_bulk,     BULK,    DROP)
+
+/****
+ * Generated payload structs
+ ****/
+#define BL_MSG_FIELD(type, name)    type name;
+
+#define BL_MSG_PAYLOAD_STRUCT(NAME, name, lane, policy, size) \
+    typedef struct { \
+        BL_MSG_##NAME##_FIELDS(BL_MSG_FIELD) \
+    } __packed bl_msg_##name##_t; \
+    BUILD_ASSERT(sizeof(bl_msg_##name##_t) == (size), \
+                 "bl_msg_" #name "_t does not match its registered wire size");
+
+BL_IPC_MSG_TABLE(BL_MSG_PAYLOAD_STRUCT)
+
+#endif /* bl_ipc_msg_def_H_ */
@@ -0,0 +1,436 @@
+/****
+* File Name    : bl_ipc_rpc.c
+* Version      : 1.0.0
+* Description  : Request/response calls over the inter-core IPC.
+*                A request is an ordinary message whose header carries a non-zero
+*                rpc_id; the server answers with BL_MSG_TYPE_RPC_RESPONSE and the
+*                same rpc_id. Up to BL_RPC_MAX_PENDING requests may be in flight,
+*                each completed by its response or by its own timeout.
+* Creation Date: Oct 2026
+****/
+
+/****
+ * Includes
+ ****/
+#include "bl_isw.h"
+#include "bl_zephyr_osal_cfg.h"
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_REGISTER(bl_rpc, LOG_LEVEL_INF);
+
+/****
+ * Typedef definitions
+ ****/
+
+/* Outstanding request */
+typedef struct {
+    bool busy;                          /* Allocated, until its completion has run */
+    uint32_t id;                        /* 0 once claimed by response or timeout */
+    uint16_t msg_type;
+    uint64_t start_us;                  /* Local time the request was sent */
+    k_timepoint_t deadline;
+    bl_rpc_done_t done;
+    void *arg;
+    struct k_work_delayable timeout_work;
+} bl_rpc_slot_t;
+
+/* Request taken out of its slot by whichever of response and timeout won */
+typedef struct {
+    bl_rpc_slot_t *slot;
+    uint32_t id;
+    uint16_t msg_type;
+    uint64_t start_us;
+    bl_rpc_done_t done;
+    void *arg;
+} bl_rpc_claim_t;
+
+/****
+ * Global variables
+ ****/
+static bl_rpc_slot_t bl_rpc_slots[BL_RPC_MAX_PENDING];
+static struct k_spinlock bl_rpc_lock;
+static uint32_t bl_rpc_next_id;
+static bl_rpc_stats_t bl_rpc_stats[BL_MSG_TYPE_MAX];
+
+/* Free slots; a caller with too many requests in flight waits here */
+static K_SEM_DEFINE(bl_rpc_free_sem, BL_RPC_MAX_PENDING, BL_RPC_MAX_PENDING);
+
+/****
+ * Static function prototypes
+ ****/
+static bool bl_rpc_claim(bl_rpc_slot_t *slot, uint32_t id, bool expired_only,
+                         bl_rpc_claim_t *claim);
+static void bl_rpc_free(bl_rpc_slot_t *slot);
+static void bl_rpc_complete(const bl_rpc_claim_t *claim, const bl_rpc_result_t *result,
+                            bool timed_out);
+static void bl_rpc_timeout_work(struct k_work *work);
+static void bl_rpc_response_handler(const bl_ipc_msg_t *msg, void *ctx);
+static void bl_rpc_future_done(const bl_rpc_result_t *result, void *arg);
+
+/****
+ * Function implementations
+ ****/
+
+/**
+ * @brief Take ownership of an outstanding request
+ *
+ * Whichever of response and timeout claims the request first completes it;
+ * the other finds it gone. The request is copied out under the lock, and the
+ * slot stays allocated until bl_rpc_free(), so a new request cannot reuse it
+ * while the claimed one is still being completed. slot NULL searches by id;
+ * expired_only keeps a late timeout run from completing a newer request.
+ */
+static bool bl_rpc_claim(bl_rpc_slot_t *slot, uint32_t id, bool expired_only,
+                         bl_rpc_claim_t *claim)
+{
+    k_spinlock_key_t key = k_spin_lock(&bl_rpc_lock);
+    bl_rpc_slot_t *found = NULL;
+
+    for (uint32_t i = 0; i < BL_RPC_MAX_PENDING; i++) {
+        bl_rpc_slot_t *s = &bl_rpc_slots[i];
+
+        if ((slot == NULL || s == slot) && s->id != 0U && (id == 0U || s->id == id) &&
+            (!expired_only || sys_timepoint_expired(s->deadline))) {
+            found = s;
+            break;
+        }
+    }
+
+    if (found) {
+        claim->slot = found;
+        claim->id = found->id;
+        claim->msg_type = found->msg_type;
+        claim->start_us = found->start_us;
+        claim->done = found->done;
+        claim->arg = found->arg;
+        found->id = 0;
+    }
+
+    k_spin_unlock(&bl_rpc_lock, key);
+    return found != NULL;
+}
+
+/**
+ * @brief Return a claimed slot, its timeout already cancelled or run
+ */
+static void bl_rpc_free(bl_rpc_slot_t *slot)
+{
+    k_spinlock_key_t key = k_spin_lock(&bl_rpc_lock);
+
+    slot->busy = false;
+    k_spin_unlock(&bl_rpc_lock, key);
+
+    k_sem_give(&bl_rpc_free_sem);
+}
+
+/**
+ * @brief Account a finished request, run its callback and free its slot
+ */
+static void bl_rpc_complete(const bl_rpc_claim_t *claim, const bl_rpc_result_t *result,
+                            bool timed_out)
+{
+    bl_rpc_stats_t *stats = &bl_rpc_stats[claim->msg_type];
+    k_spinlock_key_t key;
+
+    key = k_spin_lock(&bl_rpc_lock);
+    if (timed_out) {
+        stats->timeouts++;
+    } else {
+        stats->completed++;
+        if (result->status < 0) {
+            stats->failed++;
+        }
+        if (stats->completed == 1U || result->rtt_us < stats->rtt_min_us) {
+            stats->rtt_min_us = result->rtt_us;
+        }
+        stats->rtt_max_us = MAX(stats->rtt_max_us, result->rtt_us);
+        stats->rtt_total_us += result->rtt_us;
+    }
+    k_spin_unlock(&bl_rpc_lock, key);
+
+    if (claim->done) {
+        claim->done(result, claim->arg);
+    }
+
+    bl_rpc_free(claim->slot);
+}
+
+/**
+ * @brief A request went without a response for its whole timeout
+ *
+ * Runs from the work item of its slot, so the timer is not pending anymore
+ * when the slot is freed.
+ */
+static void bl_rpc_timeout_work(struct k_work *work)
+{
+    struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+    bl_rpc_slot_t *slot = CONTAINER_OF(dwork, bl_rpc_slot_t, timeout_work);
+    bl_rpc_result_t result = { .status = -ETIMEDOUT };
+    bl_rpc_claim_t claim;
+
+    if (bl_rpc_claim(slot, 0U, true, &claim)) {
+        LOG_WRN("RPC %u (type %u) timed out", claim.id, claim.msg_type);
+        bl_rpc_complete(&claim, &result, true);
+    }
+}
+
+/**
+ * @brief Response from the peer: complete the matching request
+ */
+static void bl_rpc_response_handler(const bl_ipc_msg_t *msg, void *ctx)
+{
+    const bl_msg_rpc_response_t *rsp = bl_msg_rpc_response_decode(msg);
+    uint64_t now = bl_osal_get_local_time_us();
+    struct k_work_sync sync;
+    bl_rpc_result_t result;
+    bl_rpc_claim_t claim;
+
+    ARG_UNUSED(ctx);
+
+    if (msg->rpc_id == 0U || !bl_rpc_claim(NULL, msg->rpc_id, false, &claim)) {
+        /* Already timed out */
+        LOG_DBG("Late RPC response %u", msg->rpc_id);
+        return;
+    }
+
+    /* The timer must be idle before the slot can be handed out again */
+    (void)k_work_cancel_delayable_sync(&claim.slot->timeout_work, &sync);
+
+    result.status = rsp->status;
+    result.rtt_us = (uint32_t)MIN(now - claim.start_us, UINT32_MAX);
+    result.service_us = rsp->service_us;
+
+    bl_rpc_complete(&claim, &result, false);
+}
+
+/**
+ * @brief Initialize the RPC layer
+ *
+ * Responses are handled by bl_ipc_dispatch(), so a core issuing requests
+ * needs a thread dispatching its control lane.
+ */
+void bl_rpc_init(void)
+{
+    for (uint32_t i = 0; i < BL_RPC_MAX_PENDING; i++) {
+        bl_rpc_slots[i].busy = false;
+        bl_rpc_slots[i].id = 0;
+        k_work_init_delayable(&bl_rpc_slots[i].timeout_work, bl_rpc_timeout_work);
+    }
+
+    bl_ipc_register_handler(BL_MSG_TYPE_RPC_RESPONSE, bl_rpc_response_handler, NULL);
+}
+
+/**
+ * @brief Send a request; done is called once with its outcome
+ *
+ * Waits up to timeout for a free slot when BL_RPC_MAX_PENDING requests are
+ * already outstanding; the same timeout then applies to the response.
+ * done is not called when the request could not be sent.
+ * @return ID of the request (> 0), negative errno if it was not sent
+ */
+int bl_rpc_call_async(bl_ipc_msg_t *req, k_timeout_t timeout, bl_rpc_done_t done, void *arg)
+{
+    k_timepoint_t deadline = sys_timepoint_calc(timeout);
+    bl_rpc_slot_t *slot = NULL;
+    k_spinlock_key_t key;
+    uint32_t id;
+    int ret;
+
+    if (!req || req->msg_type >= BL_MSG_TYPE_MAX || req->msg_type == BL_MSG_TYPE_RPC_RESPONSE) {
+        return -EINVAL;
+    }
+
+    if (k_sem_take(&bl_rpc_free_sem, timeout) != 0) {
+        return -EBUSY;
+    }
+
+    key = k_spin_lock(&bl_rpc_lock);
+    /* IDs are returned as positive int and 0 means "no RPC" */
+    id = ++bl_rpc_next_id;
+    if (id > INT32_MAX) {
+        id = 1;
+        bl_rpc_next_id = 1;
+    }
+    /* The semaphore guarantees a slot that is not busy */
+    for (uint32_t i = 0; i < BL_RPC_MAX_PENDING; i++) {
+        if (!bl_rpc_slots[i].busy) {
+            slot = &bl_rpc_slots[i];
+            break;
+        }
+    }
+    slot->busy = true;
+    slot->id = id;
+    slot->msg_type = req->msg_type;
+    slot->start_us = bl_osal_get_local_time_us();
+    slot->deadline = deadline;
+    slot->done = done;
+    slot->arg = arg;
+    bl_rpc_stats[req->msg_type].calls++;
+    k_spin_unlock(&bl_rpc_lock, key);
+
+    ret = bl_ipc_send_msg_id(req, id);
+    if (ret < 0) {
+        /* Neither sent nor armed, so nothing else can complete it */
+        key = k_spin_lock(&bl_rpc_lock);
+        slot->id = 0;
+        bl_rpc_stats[req->msg_type].calls--;
+        k_spin_unlock(&bl_rpc_lock, key);
+        bl_rpc_free(slot);
+        return ret;
+    }
+
+    /* Armed only once sent. A response that came first has claimed the
+     * slot already; one that comes later cancels the timer.
+     */
+    key = k_spin_lock(&bl_rpc_lock);
+    if (slot->id == id && !K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+        k_work_reschedule(&slot->timeout_work, sys_timepoint_timeout(deadline));
+    }
+    k_spin_unlock(&bl_rpc_lock, key);
+
+    return (int)id;
+}
+
+/**
+ * @brief Completion callback of requests started with bl_rpc_start()
+ */
+static void bl_rpc_future_done(const bl_rpc_result_t *result, void *arg)
+{
+    bl_rpc_future_t *future = arg;
+
+    future->result = *result;
+    k_sem_give(&future->done);
+}
+
+/**
+ * @brief Send a request and return at once; collect it with bl_rpc_wait()
+ *
+ * Starting several futures before waiting on any keeps a sequence of
+ * commands in flight together.
+ */
+int bl_rpc_start(bl_rpc_future_t *future, bl_ipc_msg_t *req, k_timeout_t timeout)
+{
+    int ret;
+
+    if (!future) {
+        return -EINVAL;
+    }
+
+    k_sem_init(&future->done, 0, 1);
+    future->result.status = -EINPROGRESS;
+    future->result.rtt_us = 0;
+    future->result.service_us = 0;
+
+    ret = bl_rpc_call_async(req, timeout, bl_rpc_future_done, future);
+    if (ret < 0) {
+        future->result.status = ret;
+        k_sem_give(&future->done);
+        return ret;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Wait for a started request to complete
+ * @return Result of the request, -EAGAIN if still outstanding after timeout
+ */
+int bl_rpc_wait(bl_rpc_future_t *future, k_timeout_t timeout)
+{
+    if (!future) {
+        return -EINVAL;
+    }
+
+    if (k_sem_take(&future->done, timeout) != 0) {
+        return -EAGAIN;
+    }
+
+    /* Leave the future completed for later calls */
+    k_sem_give(&future->done);
+    return future->result.status;
+}
+
+/**
+ * @brief Send a request and wait for its response
+ * @return Result of the request, negative errno on failure or timeout
+ */
+int bl_rpc_call(bl_ipc_msg_t *req, k_timeout_t timeout, bl_rpc_result_t *result)
+{
+    bl_rpc_future_t future;
+    int ret;
+
+    (void)bl_rpc_start(&future, req, timeout);
+    ret = bl_rpc_wait(&future, K_FOREVER);
+
+    if (result) {
+        *result = future.result;
+    }
+
+    return ret;
+}
+
+/**
+ * @brief Answer a request (server side, from the request's handler)
+ *
+ * Requests sent without an ID (plain bl_ipc_send_msg()) are not answered.
+ */
+int bl_rpc_reply(const bl_ipc_msg_t *req, int status)
+{
+    bl_msg_rpc_response_t rsp = {0};
+    bl_ipc_msg_t msg;
+
+    if (!req) {
+        return -EINVAL;
+    }
+
+    if (req->rpc_id == 0U) {
+        return 0;
+    }
+
+    rsp.status = status;
+    rsp.request_type = req->msg_type;
+    rsp.service_us = (uint32_t)MIN(bl_osal_get_time_us() - req->timestamp, UINT32_MAX);
+    bl_msg_rpc_response_encode(&msg, &rsp);
+
+    return bl_ipc_send_msg_id(&msg, req->rpc_id);
+}
+
+/**
+ * @brief Get the RPC statistics of one request type
+ */
+void bl_rpc_get_stats(bl_msg_type_t msg_type, bl_rpc_stats_t *stats)
+{
+    k_spinlock_key_t key;
+
+    if (msg_type >= BL_MSG_TYPE_MAX || !stats) {
+        return;
+    }
+
+    key = k_spin_lock(&bl_rpc_lock);
+    *stats = bl_rpc_stats[msg_type];
+    k_spin_unlock(&bl_rpc_lock, key);
+}
+
+/**
+ * @brief Log the RPC statistics of every request type in use
+ *
+ * Intended to be called once per second (1000ms task).
+ */
+void bl_rpc_log_stats(void)
+{
+    bl_rpc_stats_t stats;
+
+    for (uint32_t type = 0; type < BL_MSG_TYPE_MAX; type++) {
+        bl_rpc_get_stats((bl_msg_type_t)type, &stats);
+        if (stats.calls == 0U) {
+            continue;
+        }
+
+        LOG_INF("RPC type %u: %u calls, %u done, %u failed, %u timeouts, "
+                "rtt min/avg/max %u/%u/%u us",
+                type, stats.calls, stats.completed, stats.failed, stats.timeouts,
+                stats.rtt_min_us,
+                stats.completed ? (uint32_t)(stats.rtt_total_us / stats.completed) : 0U,
+                stats.rtt_max_us);
+    }
+}
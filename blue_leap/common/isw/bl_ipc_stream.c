@@ -0,0 +1,275 @@
+/****
+* File Name    : bl_ipc_stream.c
+* Version      : 1.0.0
+* Description  : Lock-free single-producer/single-consumer sample stream in shared memory.
+*                The producer only writes head, the consumer only writes tail, so
+*                no lock or atomic read-modify-write is needed between the cores.
+* Creation Date: Oct 2026
+****/
+
+/****
+ * Includes
+ ****/
+#include "bl_ipc_stream.h"
+#include <zephyr/cache.h>
+#include <zephyr/sys/barrier.h>
+#include <string.h>
+
+/****
+ * Static function prototypes
+ ****/
+static void bl_stream_copy_in(bl_stream_t *stream, uint32_t pos, const uint8_t *src, uint32_t count);
+static void bl_stream_copy_out(bl_stream_t *stream, uint32_t pos, uint8_t *dst, uint32_t count);
+
+/****
+ * Function implementations
+ ****/
+
+/**
+ * @brief Copy samples into the ring, handling wrap-around, and clean the cache
+ */
+static void bl_stream_copy_in(bl_stream_t *stream, uint32_t pos, const uint8_t *src, uint32_t count)
+{
+    uint32_t idx = pos & stream->mask;
+    uint32_t first = MIN(count, stream->mask + 1U - idx);
+    uint8_t *dst = &stream->shm->data[idx * stream->elem_size];
+
+    memcpy(dst, src, first * stream->elem_size);
+    sys_cache_data_flush_range(dst, first * stream->elem_size);
+
+    if (count > first) {
+        src += first * stream->elem_size;
+        memcpy(stream->shm->data, src, (count - first) * stream->elem_size);
+        sys_cache_data_flush_range(stream->shm->data, (count - first) * stream->elem_size);
+    }
+}
+
+/**
+ * @brief Invalidate the cache and copy samples out of the ring, handling wrap-around
+ */
+static void bl_stream_copy_out(bl_stream_t *stream, uint32_t pos, uint8_t *dst, uint32_t count)
+{
+    uint32_t idx = pos & stream->mask;
+    uint32_t first = MIN(count, stream->mask + 1U - idx);
+    uint8_t *src = &stream->shm->data[idx * stream->elem_size];
+
+    sys_cache_data_invd_range(src, first * stream->elem_size);
+    memcpy(dst, src, first * stream->elem_size);
+
+    if (count > first) {
+        dst += first * stream->elem_size;
+        sys_cache_data_invd_range(stream->shm->data, (count - first) * stream->elem_size);
+        memcpy(dst, stream->shm->data, (count - first) * stream->elem_size);
+    }
+}
+
+/**
+ * @brief Initialize a stream over a cache-line aligned memory area
+ *
+ * The consumer creates the stream (create = true) and sizes the ring to the
+ * largest power-of-two number of samples that fits. The producer attaches
+ * to an existing stream and fails with -EAGAIN until it has been created.
+ */
+int bl_stream_init(bl_stream_t *stream, void *mem, size_t mem_size,
+                   uint32_t elem_size, bool create)
+{
+    bl_stream_shm_t *shm = (bl_stream_shm_t *)mem;
+    uint32_t capacity;
+
+    if (!stream || !mem || elem_size == 0 ||
+        ((uintptr_t)mem % BL_CACHE_LINE_SIZE) != 0 || mem_size <= sizeof(bl_stream_shm_t)) {
+        return -EINVAL;
+    }
+
+    memset(stream, 0, sizeof(*stream));
+
+    if (create) {
+        capacity = (uint32_t)((mem_size - sizeof(bl_stream_shm_t)) / elem_size);
+        if (capacity < 2U) {
+            return -ENOMEM;
+        }
+        capacity = 1U << (31U - __builtin_clz(capacity));
+
+        shm->magic = 0;
+        shm->head = 0;
+        shm->tail = 0;
+        shm->elem_size = elem_size;
+        shm->capacity = capacity;
+        barrier_dmem_fence_full();
+        shm->magic = BL_STREAM_MAGIC;
+        sys_cache_data_flush_range(shm, sizeof(bl_stream_shm_t));
+    } else {
+        sys_cache_data_invd_range(shm, sizeof(bl_stream_shm_t));
+        if (shm->magic != BL_STREAM_MAGIC) {
+            return -EAGAIN;
+        }
+        if (shm->elem_size != elem_size) {
+            return -EINVAL;
+        }
+        capacity = shm->capacity;
+    }
+
+    stream->shm = shm;
+    stream->mask = capacity - 1U;
+    stream->elem_size = elem_size;
+    stream->head = shm->head;
+    stream->tail = shm->tail;
+    stream->doorbell_batch = BL_STREAM_DOORBELL_BATCH;
+    k_sem_init(&stream->data_sem, 0, 1);
+
+    return 0;
+}
+
+/**
+ * @brief Set the doorbell used to wake the consumer and its batch size
+ */
+void bl_stream_set_doorbell(bl_stream_t *stream, void (*doorbell)(void *arg),
+                            void *arg, uint32_t batch)
+{
+    if (!stream) {
+        return;
+    }
+
+    stream->doorbell = doorbell;
+    stream->doorbell_arg = arg;
+    stream->doorbell_batch = MAX(batch, 1U);
+}
+
+/**
+ * @brief Write samples to the stream (producer)
+ * @return Number of samples written; less than count when the ring is full
+ */
+uint32_t bl_stream_write(bl_stream_t *stream, const void *elems, uint32_t count)
+{
+    uint32_t free_slots;
+    uint32_t n;
+
+    if (!stream || !stream->shm || !elems || count == 0) {
+        return 0;
+    }
+
+    free_slots = stream->mask + 1U - (stream->head - stream->tail);
+    if (free_slots < count) {
+        /* Only fetch the consumer index when the cached view is too short */
+        sys_cache_data_invd_range((void *)&stream->shm->tail, sizeof(stream->shm->tail));
+        stream->tail = stream->shm->tail;
+        free_slots = stream->mask + 1U - (stream->head - stream->tail);
+    }
+
+    n = MIN(count, free_slots);
+    stream->stats.overruns += count - n;
+    if (n == 0) {
+        return 0;
+    }
+
+    bl_stream_copy_in(stream, stream->head, elems, n);
+
+    /* Samples must be visible before the new head */
+    barrier_dmem_fence_full();
+    stream->head += n;
+    stream->shm->head = stream->head;
+    sys_cache_data_flush_range((void *)&stream->shm->head, sizeof(stream->shm->head));
+
+    stream->stats.written += n;
+    stream->pending += n;
+    if (stream->pending >= stream->doorbell_batch) {
+        bl_stream_flush(stream);
+    }
+
+    return n;
+}
+
+/**
+ * @brief Ring the doorbell for samples published since the last one (producer)
+ */
+void bl_stream_flush(bl_stream_t *stream)
+{
+    if (!stream || stream->pending == 0) {
+        return;
+    }
+
+    stream->pending = 0;
+    stream->stats.doorbells++;
+
+    if (stream->doorbell) {
+        stream->doorbell(stream->doorbell_arg);
+    }
+}
+
+/**
+ * @brief Number of samples ready to be read (consumer)
+ */
+uint32_t bl_stream_available(bl_stream_t *stream)
+{
+    if (!stream || !stream->shm) {
+        return 0;
+    }
+
+    sys_cache_data_invd_range((void *)&stream->shm->head, sizeof(stream->shm->head));
+    stream->head = stream->shm->head;
+
+    return stream->head - stream->tail;
+}
+
+/**
+ * @brief Read up to max samples from the stream (consumer)
+ * @return Number of samples read
+ */
+uint32_t bl_stream_read(bl_stream_t *stream, void *elems, uint32_t max)
+{
+    uint32_t avail;
+    uint32_t n;
+
+    if (!stream || !stream->shm || !elems || max == 0) {
+        return 0;
+    }
+
+    avail = stream->head - stream->tail;
+    if (avail < max) {
+        avail = bl_stream_available(stream);
+    }
+
+    n = MIN(avail, max);
+    if (n == 0) {
+        return 0;
+    }
+
+    /* Do not read samples ahead of the head that announced them */
+    barrier_dmem_fence_full();
+    bl_stream_copy_out(stream, stream->tail, elems, n);
+
+    /* Samples must be consumed before the slots are handed back */
+    barrier_dmem_fence_full();
+    stream->tail += n;
+    stream->shm->tail = stream->tail;
+    sys_cache_data_flush_range((void *)&stream->shm->tail, sizeof(stream->shm->tail));
+
+    stream->stats.read += n;
+    return n;
+}
+
+/**
+ * @brief Wait until samples are available (consumer)
+ */
+int bl_stream_wait(bl_stream_t *stream, k_timeout_t timeout)
+{
+    if (!stream || !stream->shm) {
+        return -EINVAL;
+    }
+
+    if (bl_stream_available(stream) > 0) {
+        return 0;
+    }
+
+    return k_sem_take(&stream->data_sem, timeout);
+}
+
+/**
+ * @brief Doorbell receive hook: wake the consumer (ISR safe)
+ */
+void bl_stream_notify(bl_stream_t *stream)
+{
+    if (stream) {
+        k_sem_give(&stream->data_sem);
+    }
+}
@@ -0,0 +1,94 @@
+/****
+* File Name    : bl_ipc_stream.h
+* Version      : 1.0.0
+* Description  : Lock-free single-producer/single-consumer sample stream in shared memory.
+* Creation Date: Oct 2026
+****/
+#ifndef BL_IPC_STREAM_H_
+#define BL_IPC_STREAM_H_
+
+/****
+ * Includes
+ ****/
+#include <zephyr/kernel.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/****
+ * Macro definitions
+ ****/
+
+/* D-cache line size of the Cortex-M7, used to keep indices on separate lines */
+#define BL_CACHE_LINE_SIZE          32U
+
+/* Marks a stream control block as initialised by the consumer */
+#define BL_STREAM_MAGIC             0x424C5354U   /* "BLST" */
+
+/* Samples written before the producer rings the doorbell */
+#define BL_STREAM_DOORBELL_BATCH    32U
+
+/****
+ * Typedef definitions
+ ****/
+
+/* Stream control block as laid out in shared memory.
+ * head is written only by the producer, tail only by the consumer; each
+ * sits on its own cache line so that cache maintenance on one side never
+ * touches the other side's index.
+ */
+typedef struct {
+    volatile uint32_t head;
+    uint8_t reserved0[BL_CACHE_LINE_SIZE - sizeof(uint32_t)];
+    volatile uint32_t tail;
+    uint8_t reserved1[BL_CACHE_LINE_SIZE - sizeof(uint32_t)];
+    uint32_t magic;
+    uint32_t elem_size;
+    uint32_t capacity;
+    uint8_t reserved2[BL_CACHE_LINE_SIZE - (3U * sizeof(uint32_t))];
+    uint8_t data[];
+} __aligned(BL_CACHE_LINE_SIZE) bl_stream_shm_t;
+
+/* Stream statistics */
+typedef struct {
+    uint32_t written;      /* Samples accepted by the producer */
+    uint32_t read;         /* Samples delivered to the consumer */
+    uint32_t overruns;     /* Samples refused because the ring was full */
+    uint32_t doorbells;    /* Doorbells rung by the producer */
+} bl_stream_stats_t;
+
+/* Per-core stream handle (local memory) */
+typedef struct {
+    bl_stream_shm_t *shm;
+    uint32_t mask;
+    uint32_t elem_size;
+    uint32_t head;            /* Producer: own head; consumer: last seen head */
+    uint32_t tail;            /* Consumer: own tail; producer: last seen tail */
+    uint32_t pending;         /* Samples published since the last doorbell */
+    uint32_t doorbell_batch;
+    void (*doorbell)(void *arg);
+    void *doorbell_arg;
+    struct k_sem data_sem;
+    bl_stream_stats_t stats;
+} bl_stream_t;
+
+/****
+ * Global functions
+ ****/
+
+/* Set up a stream over mem; the consumer creates it, the producer attaches */
+extern int bl_stream_init(bl_stream_t *stream, void *mem, size_t mem_size,
+                          uint32_t elem_size, bool create);
+extern void bl_stream_set_doorbell(bl_stream_t *stream, void (*doorbell)(void *arg),
+                                   void *arg, uint32_t batch);
+
+/* Producer side */
+extern uint32_t bl_stream_write(bl_stream_t *stream, const void *elems, uint32_t count);
+extern void bl_stream_flush(bl_stream_t *stream);
+
+/* Consumer side */
+extern uint32_t bl_stream_read(bl_stream_t *stream, void *elems, uint32_t max);
+extern uint32_t bl_stream_available(bl_stream_t *stream);
+extern int bl_stream_wait(bl_stream_t *stream, k_timeout_t timeout);
+extern void bl_stream_notify(bl_stream_t *stream);
+
+#endif /* BL_IPC_STREAM_H_ */
@@ -12,6 +12,10 @@
 #include <zephyr/kernel.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include "bl_zephyr_osal_cfg.h"
+#include "bl_ipc_msg_def.h"
 
 /****
  * Macro definitions
@@ -32,29 +36,211 @@
 #define BL_TASK_500MS_PERIOD   500
 #define BL_TASK_1000MS_PERIOD  1000
 
+/* Cores running an ISW task */
+#define BL_ISW_ON_M7           BIT(BL_CORE_M7_ID)
+#define BL_ISW_ON_M4           BIT(BL_CORE_M4_ID)
+#define BL_ISW_ON_BOTH         (BL_ISW_ON_M7 | BL_ISW_ON_M4)
+
+/* ISW tasks: X(ID, app_fn, cores)
+ *   ID      rate group BL_OS_THREAD_<ID>_ID, scheduled by BL_OS_RATE_GROUP_TABLE
+ *   app_fn  application callback run at each release of the group
+ *   cores   cores running the task (BL_ISW_ON_*)
+ * A rate group not listed here, or not listed for a core, is not created
+ * on that core.
+ */
+#define BL_ISW_TASK_TABLE(X) \
+    X(1MS,     bl_app_1ms,     BL_ISW_ON_BOTH) \
+    X(5MS,     bl_app_5ms,     BL_ISW_ON_BOTH) \
+    X(10MS,    bl_app_10ms,    BL_ISW_ON_BOTH) \
+    X(20MS,    bl_app_20ms,    BL_ISW_ON_BOTH) \
+    X(50MS,    bl_app_50ms,    BL_ISW_ON_BOTH) \
+    X(100MS,   bl_app_100ms,   BL_ISW_ON_BOTH) \
+    X(200MS,   bl_app_200ms,   BL_ISW_ON_BOTH) \
+    X(500MS,   bl_app_500ms,   BL_ISW_ON_BOTH) \
+    X(1000MS,  bl_app_1000ms,  BL_ISW_ON_BOTH)
+
 /****
  * Typedef definitions
  ****/
 
-/* Inter-core message types */
+/* Application callback of an ISW task, called with the ID of the running core */
+typedef void (*bl_isw_app_fn_t)(uint32_t core_id);
+
+/* Inter-core message types, see bl_ipc_msg_def.h */
+#define BL_MSG_TYPE_ENUM(NAME, ...)     BL_MSG_TYPE_##NAME,
+
 typedef enum {
-    BL_MSG_TYPE_SENSOR_DATA = 0,
-    BL_MSG_TYPE_FAN_CONTROL,
-    BL_MSG_TYPE_CALIBRATION,
-    BL_MSG_TYPE_ALARM_STATUS,
-    BL_MSG_TYPE_FOTA_TRIGGER,
-    BL_MSG_TYPE_SYSTEM_STATUS,
+    BL_IPC_MSG_TABLE(BL_MSG_TYPE_ENUM)
+    BL_IPC_MSG_RAW_TABLE(BL_MSG_TYPE_ENUM)
     BL_MSG_TYPE_MAX
 } bl_msg_type_t;
 
-/* Inter-core message structure */
+/* Inter-core message lanes, highest priority first.
+ * Each lane has its own endpoint and RX queue so that alarms never wait
+ * behind queued telemetry.
+ */
+typedef enum {
+    BL_IPC_LANE_ALARM = 0,   /* Alarm and safety messages */
+    BL_IPC_LANE_CONTROL,     /* Fan, calibration, system status */
+    BL_IPC_LANE_BULK,        /* Sensor telemetry */
+    BL_IPC_LANE_MAX
+} bl_ipc_lane_t;
+
+/* Inter-core message structure
+ * The header doubles as the wire format: only BL_IPC_MSG_HDR_SIZE + data_len
+ * bytes are transferred through the vring, the unused tail of data[] is not.
+ */
 typedef struct {
-    uint32_t msg_type;
-    uint32_t timestamp;
-    uint32_t data_len;
+    uint16_t msg_type;
+    uint16_t data_len;
+    uint32_t rpc_id;            /* RPC request and its response, 0 otherwise */
+    uint64_t timestamp;         /* Send time on the shared timebase, in us */
     uint8_t  data[256];
 } bl_ipc_msg_t;
 
+/* Size of the compact message header on the wire */
+#define BL_IPC_MSG_HDR_SIZE         offsetof(bl_ipc_msg_t, data)
+
+/* Number of bytes a message occupies on the wire */
+#define BL_IPC_MSG_WIRE_SIZE(msg)   (BL_IPC_MSG_HDR_SIZE + (msg)->data_len)
+
+/* Typed payload access, generated for every type of BL_IPC_MSG_TABLE:
+ *   bl_msg_<name>_encode(msg, payload)  set type, length and payload of msg
+ *   bl_msg_<name>_decode(msg)           payload of a received msg, in place
+ * The IPC layer drops received messages whose length does not match their
+ * type, so decode only checks the type and never copies.
+ */
+#define BL_MSG_CODEC(NAME, name, lane, policy, size) \
+    static inline void bl_msg_##name##_encode(bl_ipc_msg_t *msg, const bl_msg_##name##_t *payload) \
+    { \
+        msg->msg_type = BL_MSG_TYPE_##NAME; \
+        msg->data_len = sizeof(*payload); \
+        memcpy(msg->data, payload, sizeof(*payload)); \
+    } \
+    static inline const bl_msg_##name##_t *bl_msg_##name##_decode(const bl_ipc_msg_t *msg) \
+    { \
+        return (msg->msg_type == BL_MSG_TYPE_##NAME) ? \
+               (const bl_msg_##name##_t *)msg->data : NULL; \
+    }
+
+BL_IPC_MSG_TABLE(BL_MSG_CODEC)
+
+/* Received message held in its vring buffer (zero-copy receive) */
+typedef struct {
+    const bl_ipc_msg_t *msg;    /* Header and data_len bytes of data are valid */
+    void *hold;                 /* Buffer reference, owned by the IPC layer */
+} bl_ipc_rx_desc_t;
+
+/* Inter-core sample streams (shared-memory rings, M4 -> M7) */
+typedef enum {
+    BL_IPC_STREAM_ADC = 0,   /* Raw frequency/bushing acquisition samples */
+    BL_IPC_STREAM_MAX
+} bl_ipc_stream_id_t;
+
+/* Acquisition sample carried on BL_IPC_STREAM_ADC, in ADC counts */
+typedef struct {
+    uint64_t timestamp;         /* Shared timebase, us */
+    uint16_t voltage;
+    uint16_t current;
+    uint16_t frequency;
+    uint16_t flags;             /* BL_ADC_SAMPLE_* */
+} bl_adc_sample_t;
+
+/* Test ramp generated without an ADC (native_sim), not a measurement */
+#define BL_ADC_SAMPLE_SYNTHETIC     BIT(0)
+/* Offset/gain correction from a calibration step applied by M4 */
+#define BL_ADC_SAMPLE_CALIBRATED    BIT(1)
+
+/* Latest-value mailboxes (shared memory, M4 -> M7) */
+typedef enum {
+    BL_IPC_MAILBOX_SENSOR = 0,   /* Latest bl_sensor_data_t snapshot */
+    BL_IPC_MAILBOX_MAX
+} bl_ipc_mailbox_id_t;
+
+/* Sensor snapshot carried on BL_IPC_MAILBOX_SENSOR, same layout as the
+ * BL_MSG_TYPE_SENSOR_DATA payload
+ */
+typedef bl_msg_sensor_data_t bl_sensor_data_t;
+
+/* IPC transmit path statistics */
+typedef struct {
+    uint32_t msg_count;      /* Messages sent over this path */
+    uint32_t bytes_copied;   /* Bytes copied by the IPC layer into the vring */
+    uint32_t bytes_sent;     /* Bytes put on the wire */
+    uint64_t cycles;         /* CPU cycles spent inside the IPC layer */
+} bl_ipc_tx_path_stats_t;
+
+typedef struct {
+    bl_ipc_tx_path_stats_t copy;    /* bl_ipc_send_msg() */
+    bl_ipc_tx_path_stats_t nocopy;  /* bl_ipc_alloc_tx() / bl_ipc_commit_tx() */
+    uint32_t buffers_sent;          /* vring buffers (doorbells) sent, both paths */
+} bl_ipc_tx_stats_t;
+
+/* Cores taking part in inter-core communication */
+typedef enum {
+    BL_IPC_CORE_M7 = 0,
+    BL_IPC_CORE_M4,
+    BL_IPC_CORE_MAX
+} bl_ipc_core_t;
+
+/* Per-type message counters of one core, readable from both cores */
+typedef struct {
+    uint32_t sent;           /* Messages handed to the peer */
+    uint32_t received;       /* Messages queued for local consumers */
+    uint32_t dropped;        /* Messages lost on this core, sending or receiving */
+    uint32_t backpressure;   /* Sends that found the peer without a free RX slot */
+} bl_ipc_type_stats_t;
+
+/* Handler invoked by bl_ipc_dispatch() for one message type */
+typedef void (*bl_ipc_handler_t)(const bl_ipc_msg_t *msg, void *ctx);
+
+/* Per-type dispatch statistics */
+typedef struct {
+    uint32_t count;          /* Messages passed to the handler */
+    uint32_t unhandled;      /* Messages dropped for lack of a handler */
+    uint32_t max_cycles;     /* Longest handler execution */
+    uint64_t cycles;         /* Total handler execution time */
+} bl_ipc_handler_stats_t;
+
+/* Outcome of an RPC */
+typedef struct {
+    int status;              /* Server result, -ETIMEDOUT without a response */
+    uint32_t rtt_us;         /* Request sent to response received, 0 on timeout */
+    uint32_t service_us;     /* Request sent to response sent, on the shared timebase */
+} bl_rpc_result_t;
+
+/* Completion callback of bl_rpc_call_async(); runs in the thread dispatching
+ * the response, or in the system work queue on timeout
+ */
+typedef void (*bl_rpc_done_t)(const bl_rpc_result_t *result, void *arg);
+
+/* RPC future: started with bl_rpc_start(), collected with bl_rpc_wait() */
+typedef struct {
+    struct k_sem done;
+    bl_rpc_result_t result;
+} bl_rpc_future_t;
+
+/* Per-request-type RPC statistics of the calling core */
+typedef struct {
+    uint32_t calls;          /* Requests sent */
+    uint32_t completed;      /* Responses received */
+    uint32_t failed;         /* Responses with a negative status */
+    uint32_t timeouts;       /* Requests without a response in time */
+    uint32_t rtt_min_us;
+    uint32_t rtt_max_us;
+    uint64_t rtt_total_us;   /* Sum over completed requests */
+} bl_rpc_stats_t;
+
+/* Clock synchronisation of M4 to the M7 timebase */
+typedef struct {
+    bool synced;             /* At least one offset estimate is in use */
+    int64_t offset_us;       /* M7 time minus M4 local time at the last update */
+    int32_t drift_ppb;       /* M4 clock rate error relative to M7 */
+    uint32_t rtt_us;         /* Round trip of the sample used for the last update */
+    uint32_t exchanges;      /* Replies received */
+    uint32_t updates;        /* Offset updates */
+} bl_time_sync_stats_t;
+
 /* System status structure */
 typedef struct {
     bool system_initialized;
@@ -67,63 +253,82 @@ typedef struct {
  * Global functions
  ****/
 
-/* Core application software initialization functions */
+/* ISW initialization of the running core: OSAL, IPC and rate groups */
 extern void bl_isw_init(void);
-extern void bl_isw_init_m7(void);
-extern void bl_isw_init_m4(void);
-
-/* Core data initialization functions */
-extern void bl_isw_data_init_m7(void);
-extern void bl_isw_data_init_m4(void);
-
-/* M7 (Cortex-M7) Initialization functions for corresponding threads */
-extern void bl_isw_t1ms_init_m7(void);
-extern void bl_isw_t5ms_init_m7(void);
-extern void bl_isw_t10ms_init_m7(void);
-extern void bl_isw_t20ms_init_m7(void);
-extern void bl_isw_t50ms_init_m7(void);
-extern void bl_isw_t100ms_init_m7(void);
-extern void bl_isw_t200ms_init_m7(void);
-extern void bl_isw_t500ms_init_m7(void);
-extern void bl_isw_t1000ms_init_m7(void);
-
-/* M7 (Cortex-M7) Main processing functions for corresponding threads */
-extern void bl_isw_t1ms_main_m7(void);
-extern void bl_isw_t5ms_main_m7(void);
-extern void bl_isw_t10ms_main_m7(void);
-extern void bl_isw_t20ms_main_m7(void);
-extern void bl_isw_t50ms_main_m7(void);
-extern void bl_isw_t100ms_main_m7(void);
-extern void bl_isw_t200ms_main_m7(void);
-extern void bl_isw_t500ms_main_m7(void);
-extern void bl_isw_t1000ms_main_m7(void);
-
-/* M4 (Cortex-M4) Initialization functions for corresponding threads */
-extern void bl_isw_t1ms_init_m4(void);
-extern void bl_isw_t5ms_init_m4(void);
-extern void bl_isw_t10ms_init_m4(void);
-extern void bl_isw_t20ms_init_m4(void);
-extern void bl_isw_t50ms_init_m4(void);
-extern void bl_isw_t100ms_init_m4(void);
-extern void bl_isw_t200ms_init_m4(void);
-extern void bl_isw_t500ms_init_m4(void);
-extern void bl_isw_t1000ms_init_m4(void);
-
-/* M4 (Cortex-M4) Main processing functions for corresponding threads */
-extern void bl_isw_t1ms_main_m4(void);
-extern void bl_isw_t5ms_main_m4(void);
-extern void bl_isw_t10ms_main_m4(void);
-extern void bl_isw_t20ms_main_m4(void);
-extern void bl_isw_t50ms_main_m4(void);
-extern void bl_isw_t100ms_main_m4(void);
-extern void bl_isw_t200ms_main_m4(void);
-extern void bl_isw_t500ms_main_m4(void);
-extern void bl_isw_t1000ms_main_m4(void);
+
+/* Application callbacks of BL_ISW_TASK_TABLE, implemented by the application */
+extern void bl_app_1ms(uint32_t core_id);
+extern void bl_app_5ms(uint32_t core_id);
+extern void bl_app_10ms(uint32_t core_id);
+extern void bl_app_20ms(uint32_t core_id);
+extern void bl_app_50ms(uint32_t core_id);
+extern void bl_app_100ms(uint32_t core_id);
+extern void bl_app_200ms(uint32_t core_id);
+extern void bl_app_500ms(uint32_t core_id);
+extern void bl_app_1000ms(uint32_t core_id);
 
 /* Inter-core communication functions */
 extern int bl_ipc_send_msg(bl_ipc_msg_t *msg);
+extern int bl_ipc_send_msg_id(bl_ipc_msg_t *msg, uint32_t rpc_id);
 extern int bl_ipc_recv_msg(bl_ipc_msg_t *msg, k_timeout_t timeout);
 
+/* Zero-copy receive: read the message in shared memory, then release it */
+extern int bl_ipc_recv_hold(bl_ipc_rx_desc_t *desc, k_timeout_t timeout);
+extern void bl_ipc_recv_release(bl_ipc_rx_desc_t *desc);
+
+/* Copy of a received message in a pool buffer owned by the caller */
+extern bl_ipc_msg_t *bl_ipc_msg_keep(const bl_ipc_msg_t *msg);
+
+extern int bl_ipc_recv_lane_msg(bl_ipc_lane_t lane, bl_ipc_msg_t *msg, k_timeout_t timeout);
+extern bl_ipc_lane_t bl_ipc_get_lane(uint32_t msg_type);
+
+/* Zero-copy transmit: borrow a message in shared memory, fill it, commit it */
+extern bl_ipc_msg_t* bl_ipc_alloc_tx(bl_msg_type_t msg_type, k_timeout_t timeout);
+extern int bl_ipc_commit_tx(bl_ipc_msg_t *msg);
+extern void bl_ipc_abort_tx(bl_ipc_msg_t *msg);
+
+/* Send coalesced messages still waiting for their batch deadline */
+extern void bl_ipc_flush(void);
+
+/* Message dispatch: handlers run in the thread calling bl_ipc_dispatch() */
+extern int bl_ipc_register_handler(bl_msg_type_t msg_type, bl_ipc_handler_t handler, void *ctx);
+extern int bl_ipc_dispatch(k_timeout_t timeout);
+extern void bl_ipc_get_handler_stats(bl_msg_type_t msg_type, bl_ipc_handler_stats_t *stats);
+extern void bl_ipc_log_handler_stats(void);
+
+/* Request/response calls: several may be outstanding, each with its own timeout.
+ * The server answers a request in its handler with bl_rpc_reply().
+ */
+extern void bl_rpc_init(void);
+extern int bl_rpc_call_async(bl_ipc_msg_t *req, k_timeout_t timeout, bl_rpc_done_t done, void *arg);
+extern int bl_rpc_start(bl_rpc_future_t *future, bl_ipc_msg_t *req, k_timeout_t timeout);
+extern int bl_rpc_wait(bl_rpc_future_t *future, k_timeout_t timeout);
+extern int bl_rpc_call(bl_ipc_msg_t *req, k_timeout_t timeout, bl_rpc_result_t *result);
+extern int bl_rpc_reply(const bl_ipc_msg_t *req, int status);
+extern void bl_rpc_get_stats(bl_msg_type_t msg_type, bl_rpc_stats_t *stats);
+extern void bl_rpc_log_stats(void);
+
+/* Inter-core sample streams */
+extern int bl_ipc_stream_write(bl_ipc_stream_id_t id, const void *samples, uint32_t count);
+extern void bl_ipc_stream_flush(bl_ipc_stream_id_t id);
+extern int bl_ipc_stream_read(bl_ipc_stream_id_t id, void *samples, uint32_t max, k_timeout_t timeout);
+
+/* Latest-value mailboxes: M4 publishes, any M7 thread reads at any time */
+extern int bl_ipc_mailbox_publish(bl_ipc_mailbox_id_t id, const void *data);
+extern int bl_ipc_mailbox_read(bl_ipc_mailbox_id_t id, void *data, uint32_t *seq);
+
+/* IPC transmit statistics */
+extern void bl_ipc_get_tx_stats(bl_ipc_tx_stats_t *stats);
+extern void bl_ipc_log_tx_stats(void);
+
+/* Per-type flow statistics of either core */
+extern int bl_ipc_get_type_stats(bl_ipc_core_t core, bl_msg_type_t msg_type, bl_ipc_type_stats_t *stats);
+extern void bl_ipc_log_flow_stats(void);
+
+/* Shared timebase synchronisation (M4 follows M7) */
+extern void bl_ipc_get_time_sync_stats(bl_time_sync_stats_t *stats);
+extern void bl_ipc_log_time_sync_stats(void);
+
 /* System status functions */
 extern bl_system_status_t* bl_get_system_status(void);
 extern void bl_set_system_initialized(bool status);
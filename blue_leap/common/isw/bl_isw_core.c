@@ -0,0 +1,156 @@
+/****
+* File Name    : bl_isw_core.c
+* Version      : 1.0.0
+* Description  : ISW runtime shared by the M7 and M4 images. The rate groups
+*                run on a core and the application callbacks they call come
+*                from BL_ISW_TASK_TABLE; the per-core parts are selected at
+*                compile time from CORE_CM7 / CORE_CM4.
+* Creation Date: Oct 2026
+****/
+
+/****
+ * Includes
+ ****/
+#include "bl_isw.h"
+#include "bl_zephyr_osal_cfg.h"
+#include <zephyr/logging/log.h>
+#include <zephyr/kernel.h>
+
+LOG_MODULE_REGISTER(bl_isw, LOG_LEVEL_INF);
+
+/****
+ * Macro definitions
+ ****/
+#if defined(CORE_CM7)
+#define BL_ISW_CORE_ID               BL_CORE_M7_ID
+#define BL_ISW_CORE_NAME             "M7"
+#define BL_ISW_TASK_STATUS(status)   ((status)->m7_task_status)
+#elif defined(CORE_CM4)
+#define BL_ISW_CORE_ID               BL_CORE_M4_ID
+#define BL_ISW_CORE_NAME             "M4"
+#define BL_ISW_TASK_STATUS(status)   ((status)->m4_task_status)
+#else
+#error "Define CORE_CM7 or CORE_CM4"
+#endif
+
+/* Rate group that also logs the ISW and IPC statistics */
+#define BL_ISW_STATS_GROUP_ID        BL_OS_THREAD_1000MS_ID
+
+#define BL_ISW_ON_THIS_CORE(cores)   (((cores) & BIT(BL_ISW_CORE_ID)) != 0U)
+
+#define BL_ISW_APP_ENTRY(ID, app_fn, cores) \
+    [BL_OS_THREAD_##ID##_ID] = BL_ISW_ON_THIS_CORE(cores) ? (app_fn) : NULL,
+
+#define BL_ISW_MAIN_ENTRY(ID, app_fn, cores) \
+    [BL_OS_THREAD_##ID##_ID] = BL_ISW_ON_THIS_CORE(cores) ? bl_isw_group_main : NULL,
+
+/****
+ * Static function prototypes
+ ****/
+static void bl_isw_group_main(uint32_t thread_id);
+static void bl_isw_data_init(void);
+static void bl_isw_log_stats(void);
+
+/****
+ * Static variables
+ ****/
+static uint32_t bl_isw_task_counter[BL_OS_MAX_NUM_THREADS];
+
+/* Application callback of each rate group run on this core */
+static const bl_isw_app_fn_t bl_isw_app[BL_OS_MAX_NUM_THREADS] = {
+    BL_ISW_TASK_TABLE(BL_ISW_APP_ENTRY)
+};
+
+/* Rate group main functions run by the executive */
+static const bl_osal_group_fn_t bl_isw_group_mains[BL_OS_MAX_NUM_THREADS] = {
+    BL_ISW_TASK_TABLE(BL_ISW_MAIN_ENTRY)
+};
+
+/****
+ * Function implementations
+ ****/
+
+/**
+ * @brief ISW initialization of this core
+ */
+void bl_isw_init(void)
+{
+    LOG_INF("Initializing %s ISW", BL_ISW_CORE_NAME);
+
+    /* Initialize OSAL */
+    bl_osal_init();
+
+    /* Initialize IPC */
+    bl_osal_ipc_init();
+
+    /* Initialize data structures */
+    bl_isw_data_init();
+
+    /* Release the rate groups */
+    bl_osal_exec_start(bl_isw_group_mains);
+
+    LOG_INF("%s ISW initialization complete", BL_ISW_CORE_NAME);
+}
+
+/**
+ * @brief ISW data initialization
+ */
+static void bl_isw_data_init(void)
+{
+    bl_system_status_t *status = bl_get_system_status();
+
+    LOG_INF("Initializing %s data structures", BL_ISW_CORE_NAME);
+
+    /* Reset task counters */
+    for (uint32_t i = 0; i < BL_OS_MAX_NUM_THREADS; i++) {
+        bl_isw_task_counter[i] = 0;
+    }
+
+    BL_ISW_TASK_STATUS(status) = 0;
+}
+
+/**
+ * @brief Main function of every rate group: run its application callback
+ */
+static void bl_isw_group_main(uint32_t thread_id)
+{
+    bl_system_status_t *status = bl_get_system_status();
+
+    bl_isw_task_counter[thread_id]++;
+
+    bl_isw_app[thread_id](BL_ISW_CORE_ID);
+
+    /* Update task status */
+    BL_ISW_TASK_STATUS(status) |= BIT(thread_id);
+
+    if (thread_id == BL_ISW_STATS_GROUP_ID) {
+        bl_isw_log_stats();
+    }
+}
+
+/**
+ * @brief Log task and IPC statistics (once per second)
+ */
+static void bl_isw_log_stats(void)
+{
+    LOG_INF("%s Tasks - 1ms:%u, 10ms:%u, 50ms:%u, 100ms:%u, 1000ms:%u",
+            BL_ISW_CORE_NAME,
+            bl_isw_task_counter[BL_OS_THREAD_1MS_ID],
+            bl_isw_task_counter[BL_OS_THREAD_10MS_ID],
+            bl_isw_task_counter[BL_OS_THREAD_50MS_ID],
+            bl_isw_task_counter[BL_OS_THREAD_100MS_ID],
+            bl_isw_task_counter[BL_OS_THREAD_1000MS_ID]);
+
+    /* Log IPC transmit path figures */
+    bl_ipc_log_tx_stats();
+    bl_ipc_log_handler_stats();
+    bl_ipc_log_flow_stats();
+    bl_osal_exec_log_stats();
+    bl_osal_buf_log_stats();
+    bl_osal_isr_log_stats();
+#if defined(CORE_CM7)
+    bl_rpc_log_stats();
+#else
+    bl_ipc_log_time_sync_stats();
+#endif
+}
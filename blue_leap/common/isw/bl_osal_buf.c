@@ -0,0 +1,282 @@
+/****
+* File Name    : bl_osal_buf.c
+* Version      : 1.0.0
+* Description  : Message buffer pools. Fixed-size, cache-line aligned blocks
+*                in the size classes of BL_OS_BUF_CLASS_TABLE, each class a
+*                k_mem_slab, so allocation and free are O(1). Buffers are
+*                reference counted: a producer hands a buffer to several
+*                consumers without copying it, and the last one to release
+*                it returns it to its class.
+* Creation Date: Oct 2026
+****/
+
+/****
+ * Includes
+ ****/
+#include "bl_zephyr_osal_cfg.h"
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_REGISTER(bl_buf, LOG_LEVEL_INF);
+
+/****
+ * Macro definitions
+ ****/
+#define BL_BUF_CLASS_CHECK(ID, block_size, blocks) \
+    BUILD_ASSERT(((block_size) % BL_OS_BUF_ALIGN) == 0U, \
+                 "Buffer class " #ID " block size must be a multiple of the cache line"); \
+    BUILD_ASSERT((blocks) > 0U, "Buffer class " #ID " has no blocks");
+
+#define BL_BUF_CLASS_STORAGE(ID, block_size, blocks) \
+    static char __aligned(BL_OS_BUF_ALIGN) bl_buf_##ID##_mem[(block_size) * (blocks)]; \
+    static atomic_t bl_buf_##ID##_refs[blocks];
+
+#define BL_BUF_CLASS_ENTRY(ID, size, count) \
+    [BL_OS_BUF_CLASS_##ID] = { \
+        .mem = bl_buf_##ID##_mem, \
+        .refs = bl_buf_##ID##_refs, \
+        .block_size = (size), \
+        .blocks = (count), \
+    },
+
+/****
+ * Typedef definitions
+ ****/
+
+/* One size class */
+typedef struct {
+    char *const mem;
+    atomic_t *const refs;    /* Reference count of each block */
+    const uint32_t block_size;
+    const uint32_t blocks;
+    struct k_mem_slab slab;
+    bl_osal_buf_stats_t stats;
+} bl_buf_class_t;
+
+BL_OS_BUF_CLASS_TABLE(BL_BUF_CLASS_CHECK)
+
+/****
+ * Global variables
+ ****/
+BL_OS_BUF_CLASS_TABLE(BL_BUF_CLASS_STORAGE)
+
+static bl_buf_class_t bl_buf_classes[BL_OS_BUF_CLASS_MAX] = {
+    BL_OS_BUF_CLASS_TABLE(BL_BUF_CLASS_ENTRY)
+};
+
+static struct k_spinlock bl_buf_lock;
+
+/****
+ * Static function prototypes
+ ****/
+static void *bl_buf_class_alloc(bl_buf_class_t *cls, k_timeout_t timeout);
+static bl_buf_class_t *bl_buf_lookup(const void *buf, uint32_t *index);
+
+/****
+ * Function implementations
+ ****/
+
+/**
+ * @brief Set up the slab of every size class
+ */
+int bl_osal_buf_init(void)
+{
+    bl_buf_class_t *cls;
+    int ret;
+
+    for (uint32_t i = 0; i < BL_OS_BUF_CLASS_MAX; i++) {
+        cls = &bl_buf_classes[i];
+
+        ret = k_mem_slab_init(&cls->slab, cls->mem, cls->block_size, cls->blocks);
+        if (ret != 0) {
+            LOG_ERR("Buffer class %u init failed: %d", i, ret);
+            return ret;
+        }
+
+        memset(&cls->stats, 0, sizeof(cls->stats));
+        cls->stats.block_size = cls->block_size;
+        cls->stats.blocks = cls->blocks;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Take a block from one class, with one reference
+ */
+static void *bl_buf_class_alloc(bl_buf_class_t *cls, k_timeout_t timeout)
+{
+    k_spinlock_key_t key;
+    void *buf;
+    int ret;
+
+    ret = k_mem_slab_alloc(&cls->slab, &buf, timeout);
+
+    key = k_spin_lock(&bl_buf_lock);
+    if (ret == 0) {
+        atomic_set(&cls->refs[((char *)buf - cls->mem) / cls->block_size], 1);
+        cls->stats.allocs++;
+        cls->stats.used++;
+        cls->stats.used_max = MAX(cls->stats.used_max, cls->stats.used);
+    } else {
+        buf = NULL;
+        cls->stats.exhausted++;
+    }
+    k_spin_unlock(&bl_buf_lock, key);
+
+    return buf;
+}
+
+/**
+ * @brief Allocate a buffer of at least size bytes
+ *
+ * Tries the smallest class that fits, then the larger ones; only the
+ * smallest class is waited on.
+ * @return Buffer holding one reference, NULL if none was free until the timeout
+ */
+void *bl_osal_buf_alloc(size_t size, k_timeout_t timeout)
+{
+    uint32_t first = BL_OS_BUF_CLASS_MAX;
+    void *buf;
+
+    if (size == 0U) {
+        return NULL;
+    }
+
+    for (uint32_t i = 0; i < BL_OS_BUF_CLASS_MAX; i++) {
+        if (size > bl_buf_classes[i].block_size) {
+            continue;
+        }
+        if (first == BL_OS_BUF_CLASS_MAX) {
+            first = i;
+        }
+
+        buf = bl_buf_class_alloc(&bl_buf_classes[i], K_NO_WAIT);
+        if (buf) {
+            return buf;
+        }
+    }
+
+    if (first == BL_OS_BUF_CLASS_MAX || K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+        return NULL;
+    }
+
+    return bl_buf_class_alloc(&bl_buf_classes[first], timeout);
+}
+
+/**
+ * @brief Find the class and block index of a buffer
+ */
+static bl_buf_class_t *bl_buf_lookup(const void *buf, uint32_t *index)
+{
+    const char *p = (const char *)buf;
+    bl_buf_class_t *cls;
+
+    for (uint32_t i = 0; i < BL_OS_BUF_CLASS_MAX; i++) {
+        cls = &bl_buf_classes[i];
+        if (p >= cls->mem && p < cls->mem + (cls->block_size * cls->blocks)) {
+            *index = (uint32_t)(p - cls->mem) / cls->block_size;
+            return cls;
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Take one more reference to a buffer, for one more consumer
+ * @return buf
+ */
+void *bl_osal_buf_ref(void *buf)
+{
+    bl_buf_class_t *cls;
+    uint32_t index;
+
+    cls = buf ? bl_buf_lookup(buf, &index) : NULL;
+    if (!cls) {
+        return NULL;
+    }
+
+    atomic_inc(&cls->refs[index]);
+    return buf;
+}
+
+/**
+ * @brief Drop one reference to a buffer; the last one frees it
+ */
+void bl_osal_buf_unref(void *buf)
+{
+    bl_buf_class_t *cls;
+    k_spinlock_key_t key;
+    uint32_t index;
+    atomic_val_t refs;
+
+    cls = buf ? bl_buf_lookup(buf, &index) : NULL;
+    if (!cls) {
+        return;
+    }
+
+    refs = atomic_dec(&cls->refs[index]);
+    if (refs > 1) {
+        return;
+    }
+    if (refs < 1) {
+        atomic_inc(&cls->refs[index]);
+        LOG_ERR("Buffer %p released more often than referenced", buf);
+        return;
+    }
+
+    k_mem_slab_free(&cls->slab, (void *)(cls->mem + (index * cls->block_size)));
+
+    key = k_spin_lock(&bl_buf_lock);
+    cls->stats.used--;
+    k_spin_unlock(&bl_buf_lock, key);
+}
+
+/**
+ * @brief Usable size of a buffer, 0 if it is not a pool buffer
+ */
+size_t bl_osal_buf_size(const void *buf)
+{
+    bl_buf_class_t *cls;
+    uint32_t index;
+
+    cls = buf ? bl_buf_lookup(buf, &index) : NULL;
+
+    return cls ? cls->block_size : 0U;
+}
+
+/**
+ * @brief Get the statistics of one size class
+ */
+int bl_osal_buf_get_stats(uint32_t class_id, bl_osal_buf_stats_t *stats)
+{
+    k_spinlock_key_t key;
+
+    if (class_id >= BL_OS_BUF_CLASS_MAX || !stats) {
+        return -EINVAL;
+    }
+
+    key = k_spin_lock(&bl_buf_lock);
+    *stats = bl_buf_classes[class_id].stats;
+    k_spin_unlock(&bl_buf_lock, key);
+
+    return 0;
+}
+
+/**
+ * @brief Log usage and exhaustion of every size class
+ */
+void bl_osal_buf_log_stats(void)
+{
+    bl_osal_buf_stats_t stats;
+
+    for (uint32_t i = 0; i < BL_OS_BUF_CLASS_MAX; i++) {
+        if (bl_osal_buf_get_stats(i, &stats) != 0) {
+            continue;
+        }
+
+        LOG_INF("Buffers %uB - used:%u/%u, max:%u, allocs:%u, exhausted:%u",
+                stats.block_size, stats.used, stats.blocks, stats.used_max,
+                stats.allocs, stats.exhausted);
+    }
+}
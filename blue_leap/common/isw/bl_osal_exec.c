@@ -0,0 +1,458 @@
+/****
+* File Name    : bl_osal_exec.c
+* Version      : 1.0.0
+* Description  : Rate-monotonic executive for the ISW rate groups.
+*                One thread per rate group, released by a single timer on an
+*                absolute 1ms schedule: the timer is re-armed for the next
+*                nominal tick, never relative to when its handler ran, so the
+*                releases do not drift. Deadlines and execution budgets are
+*                monitored per group; misses in high-criticality groups make
+*                the executive shed the low-criticality groups for a while.
+*                With BL_OS_EXEC_CYCLIC the groups are not threads: a single
+*                thread runs the groups due in each minor frame, in priority
+*                order, from a frame table computed at start-up.
+* Creation Date: Oct 2026
+****/
+
+/****
+ * Includes
+ ****/
+#include "bl_zephyr_osal_cfg.h"
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_REGISTER(bl_exec, LOG_LEVEL_INF);
+
+/****
+ * Macro definitions
+ ****/
+
+/* Executive base period; every group period is a multiple of it */
+#define BL_EXEC_TICK_MS          1U
+
+#define BL_EXEC_GROUP_CHECK(ID, period, offset, prio, stack, deadline, budget, crit) \
+    BUILD_ASSERT((offset) < (period), "Rate group " #ID " offset must be below its period"); \
+    BUILD_ASSERT(!BL_OS_EXEC_CYCLIC || (stack) <= BL_OS_EXEC_CYCLIC_STACK_SIZE, \
+                 "Rate group " #ID " stack exceeds the cyclic executive stack"); \
+    BUILD_ASSERT((deadline) > 0 && (deadline) <= (period), \
+                 "Rate group " #ID " deadline must be within its period"); \
+    BUILD_ASSERT((budget) <= (deadline) * USEC_PER_MSEC, \
+                 "Rate group " #ID " budget exceeds its deadline"); \
+    BUILD_ASSERT((BL_OS_EXEC_MAJOR_FRAME_MS % (period)) == 0, \
+                 "Rate group " #ID " period must divide the major frame");
+
+#define BL_EXEC_GROUP_ENTRY(ID, period, offset, prio, stack, deadline, budget, crit) \
+    [BL_OS_THREAD_##ID##_ID] = { \
+        .period_ms = (period), \
+        .offset_ms = (offset), \
+        .priority = (prio), \
+        .stack_size = (stack), \
+        .deadline_ms = (deadline), \
+        .budget_us = (budget), \
+        .criticality = (crit), \
+        .name = "rg_" #ID, \
+    },
+
+/****
+ * Typedef definitions
+ ****/
+
+/* Schedule of one rate group, from BL_OS_RATE_GROUP_TABLE */
+typedef struct {
+    uint32_t period_ms;
+    uint32_t offset_ms;
+    int priority;
+    uint32_t stack_size;
+    uint32_t deadline_ms;
+    uint32_t budget_us;
+    uint32_t criticality;
+    const char *name;
+} bl_exec_group_cfg_t;
+
+/* Run-time state of one rate group */
+typedef struct {
+    struct k_sem release;           /* Thread per group mode only */
+    volatile uint32_t release_ms;   /* Nominal time of the latest release */
+    volatile uint32_t release_seq;  /* Releases so far */
+    volatile uint32_t done_seq;     /* Release of the latest completed run */
+    volatile bool running;
+    bl_osal_group_fn_t main;
+    bl_osal_exec_stats_t stats;
+} bl_exec_group_t;
+
+/****
+ * Global variables
+ ****/
+BL_OS_RATE_GROUP_TABLE(BL_EXEC_GROUP_CHECK)
+
+static const bl_exec_group_cfg_t bl_exec_group_cfg[BL_OS_MAX_NUM_THREADS] = {
+    BL_OS_RATE_GROUP_TABLE(BL_EXEC_GROUP_ENTRY)
+};
+
+static struct {
+    struct k_timer timer;
+    int64_t base_ticks;             /* Tick of release 0 */
+    uint64_t base_us;               /* Local time of release 0 */
+    uint32_t now_ms;                /* Releases since release 0 */
+    volatile uint32_t shed_until_ms; /* Low-criticality groups shed before this tick */
+    bl_osal_exec_fault_fn_t fault_handler;
+    bool started;
+    struct k_spinlock lock;         /* Statistics */
+    bl_exec_group_t group[BL_OS_MAX_NUM_THREADS];
+#if BL_OS_EXEC_CYCLIC
+    struct k_sem frame;             /* Given at each minor frame with releases */
+    atomic_t pending;               /* Released groups not yet run, one bit per ID */
+#endif
+} bl_exec;
+
+/* Groups released in each minor frame of the major frame, one bit per ID */
+static uint16_t bl_exec_frame_table[BL_OS_EXEC_MAJOR_FRAME_MS / BL_EXEC_TICK_MS];
+
+BUILD_ASSERT(BL_OS_MAX_NUM_THREADS <= 16U, "Frame table entries hold 16 groups");
+
+/****
+ * Static function prototypes
+ ****/
+static void bl_exec_fault(uint32_t id, bl_osal_exec_fault_t fault);
+static void bl_exec_timer_handler(struct k_timer *timer);
+static void bl_exec_run_group(uint32_t id);
+#if BL_OS_EXEC_CYCLIC
+static void bl_exec_cyclic_thread(void *p1, void *p2, void *p3);
+#else
+static void bl_exec_group_thread(void *p1, void *p2, void *p3);
+#endif
+
+/****
+ * Function implementations
+ ****/
+
+/**
+ * @brief Account a timing fault and shed load if a high-criticality group is late
+ */
+static void bl_exec_fault(uint32_t id, bl_osal_exec_fault_t fault)
+{
+    bl_exec_group_t *group = &bl_exec.group[id];
+    bl_osal_exec_fault_fn_t handler = bl_exec.fault_handler;
+    k_spinlock_key_t key;
+
+    key = k_spin_lock(&bl_exec.lock);
+    if (fault == BL_OSAL_EXEC_DEADLINE_MISS) {
+        group->stats.deadline_misses++;
+    } else {
+        group->stats.budget_overruns++;
+    }
+    k_spin_unlock(&bl_exec.lock, key);
+
+    if (bl_exec_group_cfg[id].criticality == BL_OS_CRIT_HIGH) {
+        bl_exec.shed_until_ms = bl_exec.now_ms + BL_OS_SHED_HOLD_MS;
+    }
+
+    if (handler) {
+        handler(id, fault);
+    }
+}
+
+/**
+ * @brief Executive tick: check deadlines, release every group due now and
+ * arm the next tick
+ */
+static void bl_exec_timer_handler(struct k_timer *timer)
+{
+    uint32_t now = bl_exec.now_ms;
+    uint32_t due = bl_exec_frame_table[(now / BL_EXEC_TICK_MS) % ARRAY_SIZE(bl_exec_frame_table)];
+    uint32_t released = 0;
+    bool shedding = (int32_t)(bl_exec.shed_until_ms - now) > 0;
+
+    if (now == 0U) {
+        bl_exec.base_us = bl_osal_get_local_time_us();
+    }
+
+    for (uint32_t id = 0; id < BL_OS_MAX_NUM_THREADS; id++) {
+        const bl_exec_group_cfg_t *cfg = &bl_exec_group_cfg[id];
+        bl_exec_group_t *group = &bl_exec.group[id];
+
+        if (!group->main) {
+            continue;
+        }
+
+        /* The deadline tick of the latest release comes at the latest with
+         * the next release, so it is checked first
+         */
+        if (group->release_seq != 0U && group->done_seq != group->release_seq &&
+            now == group->release_ms + cfg->deadline_ms) {
+            bl_exec_fault(id, BL_OSAL_EXEC_DEADLINE_MISS);
+        }
+
+        if ((due & BIT(id)) == 0U) {
+            continue;
+        }
+
+        group->stats.releases++;
+        if (shedding && cfg->criticality == BL_OS_CRIT_LOW) {
+            group->stats.shed++;
+            continue;
+        }
+
+        if (group->done_seq != group->release_seq) {
+            /* The previous release has not finished; this one merges with it */
+            group->stats.overruns++;
+        }
+        group->release_ms = now;
+        group->release_seq++;
+        released |= BIT(id);
+#if !BL_OS_EXEC_CYCLIC
+        k_sem_give(&group->release);
+#endif
+    }
+
+#if BL_OS_EXEC_CYCLIC
+    if (released != 0U) {
+        atomic_or(&bl_exec.pending, (atomic_val_t)released);
+        k_sem_give(&bl_exec.frame);
+    }
+#else
+    ARG_UNUSED(released);
+#endif
+
+    bl_exec.now_ms = now + BL_EXEC_TICK_MS;
+    k_timer_start(timer,
+                  K_TIMEOUT_ABS_TICKS(bl_exec.base_ticks +
+                                      k_ms_to_ticks_near64((uint64_t)bl_exec.now_ms)),
+                  K_NO_WAIT);
+}
+
+/**
+ * @brief Run the group main function for its latest release and account it
+ */
+static void bl_exec_run_group(uint32_t id)
+{
+    const bl_exec_group_cfg_t *cfg = &bl_exec_group_cfg[id];
+    bl_exec_group_t *group = &bl_exec.group[id];
+    k_spinlock_key_t key;
+    uint64_t nominal;
+    uint64_t start;
+    uint32_t seq;
+    uint32_t jitter;
+    uint32_t exec;
+
+    start = bl_osal_get_local_time_us();
+    seq = group->release_seq;
+    nominal = bl_exec.base_us + ((uint64_t)group->release_ms * USEC_PER_MSEC);
+    jitter = (start > nominal) ? (uint32_t)MIN(start - nominal, UINT32_MAX) : 0U;
+
+    group->running = true;
+    bl_osal_prof_begin(id, cfg->period_ms);
+    group->main(id);
+    bl_osal_prof_end(id);
+    group->running = false;
+    group->done_seq = seq;
+
+    exec = (uint32_t)MIN(bl_osal_get_local_time_us() - start, UINT32_MAX);
+
+    key = k_spin_lock(&bl_exec.lock);
+    group->stats.activations++;
+    group->stats.jitter_max_us = MAX(group->stats.jitter_max_us, jitter);
+    group->stats.jitter_total_us += jitter;
+    group->stats.exec_max_us = MAX(group->stats.exec_max_us, exec);
+    k_spin_unlock(&bl_exec.lock, key);
+
+    if (exec > cfg->budget_us) {
+        bl_exec_fault(id, BL_OSAL_EXEC_BUDGET_OVERRUN);
+    }
+}
+
+#if BL_OS_EXEC_CYCLIC
+/**
+ * @brief Cyclic executive thread: run the released groups of each frame
+ *
+ * Groups run to completion, lowest ID (shortest period) first, so the
+ * order within a frame is fixed and there are no context switches between
+ * groups. A group still running when the next frame starts delays that
+ * frame; its releases are then accounted as overruns.
+ */
+static void bl_exec_cyclic_thread(void *p1, void *p2, void *p3)
+{
+    atomic_val_t pending;
+    uint32_t id;
+
+    ARG_UNUSED(p1);
+    ARG_UNUSED(p2);
+    ARG_UNUSED(p3);
+
+    while (1) {
+        k_sem_take(&bl_exec.frame, K_FOREVER);
+
+        /* Groups released meanwhile are picked up in priority order too */
+        while ((pending = atomic_get(&bl_exec.pending)) != 0) {
+            id = find_lsb_set((uint32_t)pending) - 1U;
+            atomic_and(&bl_exec.pending, ~(atomic_val_t)BIT(id));
+            bl_exec_run_group(id);
+        }
+    }
+}
+#else
+/**
+ * @brief Rate group thread: run the group main function once per release
+ */
+static void bl_exec_group_thread(void *p1, void *p2, void *p3)
+{
+    uint32_t id = POINTER_TO_UINT(p1);
+    bl_exec_group_t *group = &bl_exec.group[id];
+
+    ARG_UNUSED(p2);
+    ARG_UNUSED(p3);
+
+    while (1) {
+        k_sem_take(&group->release, K_FOREVER);
+        bl_exec_run_group(id);
+    }
+}
+#endif
+
+/**
+ * @brief Create the rate group threads and start releasing them
+ *
+ * Groups without a main function are not created. Release 0 is the tick
+ * after this call. With BL_OS_EXEC_CYCLIC a single thread with the
+ * priority of the first group runs all groups.
+ */
+int bl_osal_exec_start(const bl_osal_group_fn_t mains[BL_OS_MAX_NUM_THREADS])
+{
+    bl_thread_config_t config;
+    int ret;
+
+    if (!mains) {
+        return -EINVAL;
+    }
+
+    if (bl_exec.started) {
+        return -EALREADY;
+    }
+
+#if BL_OS_EXEC_CYCLIC
+    config.thread_id = BL_OS_THREAD_INIT_ID;
+    config.stack_size = BL_OS_EXEC_CYCLIC_STACK_SIZE;
+    config.priority = BL_THREAD_PRIORITY_IDLE;
+    config.period_ms = BL_EXEC_TICK_MS;
+    config.name = "rg_cyclic";
+    k_sem_init(&bl_exec.frame, 0, 1);
+    atomic_clear(&bl_exec.pending);
+#endif
+
+    for (uint32_t id = 0; id < BL_OS_MAX_NUM_THREADS; id++) {
+        const bl_exec_group_cfg_t *cfg = &bl_exec_group_cfg[id];
+        bl_exec_group_t *group = &bl_exec.group[id];
+
+        if (!mains[id] || cfg->period_ms == 0U) {
+            continue;
+        }
+
+        group->main = mains[id];
+
+        /* Minor frames in which the group is released */
+        for (uint32_t frame = cfg->offset_ms; frame < BL_OS_EXEC_MAJOR_FRAME_MS;
+             frame += cfg->period_ms) {
+            bl_exec_frame_table[frame / BL_EXEC_TICK_MS] |= BIT(id);
+        }
+
+#if BL_OS_EXEC_CYCLIC
+        config.priority = MIN(config.priority, (uint32_t)cfg->priority);
+#else
+        k_sem_init(&group->release, 0, 1);
+
+        config.thread_id = id;
+        config.stack_size = cfg->stack_size;
+        config.priority = cfg->priority;
+        config.period_ms = cfg->period_ms;
+        config.name = cfg->name;
+
+        ret = bl_osal_create_thread(&config, bl_exec_group_thread);
+        if (ret != 0) {
+            LOG_ERR("Rate group %u not created: %d", id, ret);
+            group->main = NULL;
+            return ret;
+        }
+#endif
+    }
+
+#if BL_OS_EXEC_CYCLIC
+    ret = bl_osal_create_thread(&config, bl_exec_cyclic_thread);
+    if (ret != 0) {
+        LOG_ERR("Cyclic executive not created: %d", ret);
+        return ret;
+    }
+#endif
+
+    bl_exec.now_ms = 0;
+    bl_exec.base_ticks = k_uptime_ticks() + 1;
+    bl_exec.started = true;
+
+    k_timer_init(&bl_exec.timer, bl_exec_timer_handler, NULL);
+    k_timer_start(&bl_exec.timer, K_TIMEOUT_ABS_TICKS(bl_exec.base_ticks), K_NO_WAIT);
+
+    LOG_INF("Executive started (%s)", BL_OS_EXEC_CYCLIC ? "cyclic" : "thread per group");
+    return 0;
+}
+
+/**
+ * @brief Get the executive statistics of one rate group
+ */
+int bl_osal_exec_get_stats(uint32_t thread_id, bl_osal_exec_stats_t *stats)
+{
+    k_spinlock_key_t key;
+
+    if (thread_id >= BL_OS_MAX_NUM_THREADS || !stats) {
+        return -EINVAL;
+    }
+
+    key = k_spin_lock(&bl_exec.lock);
+    *stats = bl_exec.group[thread_id].stats;
+    k_spin_unlock(&bl_exec.lock, key);
+
+    return 0;
+}
+
+/**
+ * @brief Log release jitter and overruns of every rate group
+ *
+ * Intended to be called once per second (1000ms task).
+ */
+void bl_osal_exec_log_stats(void)
+{
+    bl_osal_exec_stats_t stats;
+
+    for (uint32_t id = 0; id < BL_OS_MAX_NUM_THREADS; id++) {
+        if (!bl_exec.group[id].main) {
+            continue;
+        }
+
+        (void)bl_osal_exec_get_stats(id, &stats);
+        LOG_INF("%s: %u releases, %u overruns, jitter avg/max %u/%u us, exec max %u us",
+                bl_exec_group_cfg[id].name, stats.releases, stats.overruns,
+                stats.activations ? (uint32_t)(stats.jitter_total_us / stats.activations) : 0U,
+                stats.jitter_max_us, stats.exec_max_us);
+        if (stats.deadline_misses || stats.budget_overruns || stats.shed) {
+            LOG_WRN("%s: %u deadline misses, %u budget overruns, %u shed",
+                    bl_exec_group_cfg[id].name, stats.deadline_misses,
+                    stats.budget_overruns, stats.shed);
+        }
+    }
+}
+
+/**
+ * @brief Set the callback notified of deadline misses and budget overruns
+ */
+void bl_osal_exec_set_fault_handler(bl_osal_exec_fault_fn_t handler)
+{
+    bl_exec.fault_handler = handler;
+}
+
+/**
+ * @brief Whether low-criticality work is currently being shed
+ *
+ * Lets high-criticality groups skip optional work (logging, analytics)
+ * of their own while the core is overloaded.
+ */
+bool bl_osal_exec_is_shedding(void)
+{
+    return bl_exec.started && (int32_t)(bl_exec.shed_until_ms - bl_exec.now_ms) > 0;
+}
@@ -0,0 +1,218 @@
+/****
+* File Name    : bl_osal_isr.c
+* Version      : 1.0.0
+* Description  : Interrupt framework. Category 1 handlers run in interrupt
+*                context. Category 2 interrupts only give the ISR's
+*                semaphore and their handler runs in a high-priority thread
+*                of its own. The time from interrupt entry to the start of
+*                the handler is measured with the profiling counter.
+* Creation Date: Oct 2026
+****/
+
+/****
+ * Includes
+ ****/
+#include "bl_zephyr_osal_cfg.h"
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_REGISTER(bl_isr, LOG_LEVEL_INF);
+
+/****
+ * Global variables
+ ****/
+
+/* ISRs initialized, for the statistics log */
+static struct {
+    struct k_spinlock lock;
+    uint32_t count;
+    bl_osal_isr_t *isr[BL_OS_ISR_MAX];
+} bl_isr_registry;
+
+/****
+ * Static function prototypes
+ ****/
+static void bl_isr_thread(void *p1, void *p2, void *p3);
+static void bl_isr_account(bl_osal_isr_t *isr, uint32_t start, uint32_t end, uint32_t entry);
+
+/****
+ * Function implementations
+ ****/
+
+/**
+ * @brief Initialize an ISR and start its handler thread (category 2)
+ */
+int bl_osal_isr_init(bl_osal_isr_t *isr)
+{
+    const bl_osal_isr_cfg_t *cfg;
+    k_spinlock_key_t key;
+    int ret = 0;
+
+    if (!isr || !isr->cfg || !isr->cfg->handler) {
+        return -EINVAL;
+    }
+
+    cfg = isr->cfg;
+    if (cfg->category == BL_OSAL_ISR_CAT2 && !cfg->stack) {
+        return -EINVAL;
+    }
+
+    key = k_spin_lock(&bl_isr_registry.lock);
+    if (bl_isr_registry.count < BL_OS_ISR_MAX) {
+        bl_isr_registry.isr[bl_isr_registry.count++] = isr;
+    } else {
+        ret = -ENOMEM;
+    }
+    k_spin_unlock(&bl_isr_registry.lock, key);
+
+    if (ret != 0) {
+        LOG_ERR("No room to register ISR %s", cfg->name);
+        return ret;
+    }
+
+    memset(&isr->stats, 0, sizeof(isr->stats));
+    isr->stats.cycle_rate = bl_osal_prof_get_cycle_rate();
+    isr->pending = false;
+
+    if (cfg->category == BL_OSAL_ISR_CAT2) {
+        k_sem_init(&isr->sem, 0, 1);
+        k_thread_create(&isr->thread, cfg->stack, cfg->stack_size, bl_isr_thread,
+                        isr, NULL, NULL, cfg->priority, 0, K_NO_WAIT);
+        k_thread_name_set(&isr->thread, cfg->name);
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Vector entry of an ISR connected with BL_OSAL_ISR_CONNECT
+ */
+void bl_osal_isr_entry(const void *arg)
+{
+    bl_osal_isr_raise((bl_osal_isr_t *)arg, bl_osal_prof_get_cycles());
+}
+
+/**
+ * @brief Signal an interrupt (interrupt context)
+ *
+ * entry is the profiling counter read first thing in the interrupt, by the
+ * vector or the driver callback; latency counts from there to the handler
+ * start. Category 1 runs the handler now. Category 2 wakes the handler
+ * thread; interrupts taken before it runs are merged into one handler run,
+ * whose latency counts from the first of them.
+ */
+void bl_osal_isr_raise(bl_osal_isr_t *isr, uint32_t entry)
+{
+    k_spinlock_key_t key;
+    bool wake = false;
+    uint32_t start;
+
+    if (isr->cfg->category == BL_OSAL_ISR_CAT1) {
+        start = bl_osal_prof_get_cycles();
+        isr->cfg->handler(isr->cfg->arg);
+        bl_isr_account(isr, start, bl_osal_prof_get_cycles(), entry);
+        return;
+    }
+
+    key = k_spin_lock(&isr->lock);
+    isr->stats.raised++;
+    if (isr->pending) {
+        isr->stats.merged++;
+    } else {
+        isr->pending = true;
+        isr->raised_at = entry;
+        wake = true;
+    }
+    k_spin_unlock(&isr->lock, key);
+
+    if (wake) {
+        k_sem_give(&isr->sem);
+    }
+}
+
+/**
+ * @brief Handler thread of a category 2 ISR
+ */
+static void bl_isr_thread(void *p1, void *p2, void *p3)
+{
+    bl_osal_isr_t *isr = p1;
+    k_spinlock_key_t key;
+    uint32_t raised_at;
+    uint32_t start;
+
+    ARG_UNUSED(p2);
+    ARG_UNUSED(p3);
+
+    while (1) {
+        k_sem_take(&isr->sem, K_FOREVER);
+
+        /* Interrupts from here on need another run */
+        key = k_spin_lock(&isr->lock);
+        raised_at = isr->raised_at;
+        isr->pending = false;
+        k_spin_unlock(&isr->lock, key);
+
+        start = bl_osal_prof_get_cycles();
+        isr->cfg->handler(isr->cfg->arg);
+        bl_isr_account(isr, start, bl_osal_prof_get_cycles(), raised_at);
+    }
+}
+
+/**
+ * @brief Account one handler run
+ */
+static void bl_isr_account(bl_osal_isr_t *isr, uint32_t start, uint32_t end, uint32_t entry)
+{
+    k_spinlock_key_t key = k_spin_lock(&isr->lock);
+    uint32_t latency = start - entry;
+
+    if (isr->cfg->category == BL_OSAL_ISR_CAT1) {
+        isr->stats.raised++;
+    }
+    isr->stats.handled++;
+    isr->stats.latency_max = MAX(isr->stats.latency_max, latency);
+    isr->stats.latency_total += latency;
+    isr->stats.exec_max = MAX(isr->stats.exec_max, end - start);
+
+    k_spin_unlock(&isr->lock, key);
+}
+
+/**
+ * @brief Get the statistics of an ISR
+ */
+int bl_osal_isr_get_stats(bl_osal_isr_t *isr, bl_osal_isr_stats_t *stats)
+{
+    k_spinlock_key_t key;
+
+    if (!isr || !stats) {
+        return -EINVAL;
+    }
+
+    key = k_spin_lock(&isr->lock);
+    *stats = isr->stats;
+    k_spin_unlock(&isr->lock, key);
+
+    return 0;
+}
+
+/**
+ * @brief Log the statistics of every ISR initialized
+ */
+void bl_osal_isr_log_stats(void)
+{
+    bl_osal_isr_stats_t stats;
+    uint32_t count = bl_isr_registry.count;
+    uint64_t rate;
+
+    for (uint32_t i = 0; i < count; i++) {
+        bl_osal_isr_get_stats(bl_isr_registry.isr[i], &stats);
+        rate = MAX(stats.cycle_rate, 1U);
+
+        LOG_INF("ISR %s cat%d - raised:%u, handled:%u, merged:%u, latency max:%u us mean:%u us, exec max:%u us",
+                bl_isr_registry.isr[i]->cfg->name, bl_isr_registry.isr[i]->cfg->category,
+                stats.raised, stats.handled, stats.merged,
+                (uint32_t)(((uint64_t)stats.latency_max * USEC_PER_SEC) / rate),
+                stats.handled ?
+                    (uint32_t)((stats.latency_total * USEC_PER_SEC) / (rate * stats.handled)) : 0U,
+                (uint32_t)(((uint64_t)stats.exec_max * USEC_PER_SEC) / rate));
+    }
+}
@@ -0,0 +1,421 @@
+/****
+* File Name    : bl_osal_prof.c
+* Version      : 1.0.0
+* Description  : Execution time and release jitter profiler of the rate groups.
+*                Each run of a group main function is timed with the core cycle
+*                counter (DWT CYCCNT on target, the system clock on native_sim)
+*                and accounted in per-group min/max/mean and log2 histograms.
+*                The profile of the peer core is read with an RPC query.
+* Creation Date: Oct 2026
+****/
+
+/****
+ * Includes
+ ****/
+#include "bl_isw.h"
+#include "bl_zephyr_osal_cfg.h"
+#include <zephyr/logging/log.h>
+#if defined(CONFIG_SHELL)
+#include <zephyr/shell/shell.h>
+#endif
+#if defined(CONFIG_CPU_CORTEX_M_HAS_DWT)
+#include <cmsis_core.h>
+#endif
+
+LOG_MODULE_REGISTER(bl_prof, LOG_LEVEL_INF);
+
+/****
+ * Typedef definitions
+ ****/
+
+/* Run in progress of one rate group */
+typedef struct {
+    uint32_t start;          /* Counter at the start of the current run */
+    uint32_t last_start;     /* Counter at the start of the previous run */
+    uint32_t period;         /* Group period in counter cycles */
+    bool valid;              /* last_start is set */
+} bl_prof_run_t;
+
+/****
+ * Global variables
+ ****/
+static struct {
+    uint32_t cycle_rate;
+    struct k_spinlock lock;             /* Statistics */
+    bl_prof_run_t run[BL_OS_MAX_NUM_THREADS];
+    bl_osal_prof_stats_t stats[BL_OS_MAX_NUM_THREADS];
+} bl_prof;
+
+/* Latest profile received from the peer, one query at a time */
+static K_MUTEX_DEFINE(bl_prof_peer_mutex);
+static bl_osal_prof_stats_t bl_prof_peer;
+static volatile int bl_prof_peer_thread = -1;
+
+/****
+ * Static function prototypes
+ ****/
+static uint32_t bl_prof_bin(uint32_t cycles);
+static void bl_prof_query_handler(const bl_ipc_msg_t *msg, void *ctx);
+static void bl_prof_report_handler(const bl_ipc_msg_t *msg, void *ctx);
+
+/****
+ * Function implementations
+ ****/
+
+/**
+ * @brief Histogram bin of a time in cycles
+ */
+static uint32_t bl_prof_bin(uint32_t cycles)
+{
+    uint32_t bits = find_msb_set(cycles);
+
+    if (bits <= BL_PROF_HIST_SHIFT) {
+        return 0U;
+    }
+
+    return MIN(bits - BL_PROF_HIST_SHIFT, BL_PROF_HIST_BINS - 1U);
+}
+
+/**
+ * @brief Start the cycle counter and register the peer query handlers
+ */
+int bl_osal_prof_init(void)
+{
+#if defined(CONFIG_CPU_CORTEX_M_HAS_DWT)
+    /* CYCCNT is left running from its current value: the kernel may use it too */
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+#if defined(CONFIG_CPU_CORTEX_M7)
+    DWT->LAR = 0xC5ACCE55U;
+#endif
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    bl_prof.cycle_rate = SystemCoreClock;
+#else
+    bl_prof.cycle_rate = sys_clock_hw_cycles_per_sec();
+#endif
+
+    bl_osal_prof_reset();
+
+    bl_ipc_register_handler(BL_MSG_TYPE_PROF_QUERY, bl_prof_query_handler, NULL);
+    bl_ipc_register_handler(BL_MSG_TYPE_PROF_REPORT, bl_prof_report_handler, NULL);
+
+    LOG_INF("Profiler counting at %u Hz", bl_prof.cycle_rate);
+    return 0;
+}
+
+/**
+ * @brief Current value of the profiling cycle counter
+ */
+uint32_t bl_osal_prof_get_cycles(void)
+{
+#if defined(CONFIG_CPU_CORTEX_M_HAS_DWT)
+    return DWT->CYCCNT;
+#else
+    return k_cycle_get_32();
+#endif
+}
+
+/**
+ * @brief Frequency of the profiling cycle counter, Hz
+ */
+uint32_t bl_osal_prof_get_cycle_rate(void)
+{
+    return bl_prof.cycle_rate;
+}
+
+/**
+ * @brief Mark the start of a run of a rate group
+ *
+ * Called by the thread of the group only. Jitter is the deviation of the
+ * time since the previous start from period_ms.
+ */
+void bl_osal_prof_begin(uint32_t thread_id, uint32_t period_ms)
+{
+    bl_prof_run_t *run;
+
+    if (thread_id >= BL_OS_MAX_NUM_THREADS) {
+        return;
+    }
+
+    run = &bl_prof.run[thread_id];
+    run->start = bl_osal_prof_get_cycles();
+    run->period = (uint32_t)(((uint64_t)bl_prof.cycle_rate * period_ms) / MSEC_PER_SEC);
+}
+
+/**
+ * @brief Mark the end of a run of a rate group and account it
+ */
+void bl_osal_prof_end(uint32_t thread_id)
+{
+    bl_osal_prof_stats_t *stats;
+    bl_prof_run_t *run;
+    k_spinlock_key_t key;
+    uint32_t interval;
+    uint32_t jitter = 0;
+    uint32_t exec;
+
+    if (thread_id >= BL_OS_MAX_NUM_THREADS) {
+        return;
+    }
+
+    run = &bl_prof.run[thread_id];
+    stats = &bl_prof.stats[thread_id];
+    exec = bl_osal_prof_get_cycles() - run->start;
+
+    if (run->valid) {
+        interval = run->start - run->last_start;
+        jitter = (interval > run->period) ? interval - run->period : run->period - interval;
+    }
+
+    key = k_spin_lock(&bl_prof.lock);
+    stats->count++;
+    stats->exec_min = MIN(stats->exec_min, exec);
+    stats->exec_max = MAX(stats->exec_max, exec);
+    stats->exec_total += exec;
+    stats->exec_hist[bl_prof_bin(exec)]++;
+    if (run->valid) {
+        stats->jitter_max = MAX(stats->jitter_max, jitter);
+        stats->jitter_total += jitter;
+        stats->jitter_hist[bl_prof_bin(jitter)]++;
+    }
+    k_spin_unlock(&bl_prof.lock, key);
+
+    run->last_start = run->start;
+    run->valid = true;
+}
+
+/**
+ * @brief Get the profile of one rate group of this core
+ */
+int bl_osal_prof_get_stats(uint32_t thread_id, bl_osal_prof_stats_t *stats)
+{
+    k_spinlock_key_t key;
+
+    if (thread_id >= BL_OS_MAX_NUM_THREADS || !stats) {
+        return -EINVAL;
+    }
+
+    key = k_spin_lock(&bl_prof.lock);
+    *stats = bl_prof.stats[thread_id];
+    k_spin_unlock(&bl_prof.lock, key);
+
+    return 0;
+}
+
+/**
+ * @brief Clear the profiles of all rate groups of this core
+ */
+void bl_osal_prof_reset(void)
+{
+    k_spinlock_key_t key;
+
+    key = k_spin_lock(&bl_prof.lock);
+    for (uint32_t id = 0; id < BL_OS_MAX_NUM_THREADS; id++) {
+        memset(&bl_prof.stats[id], 0, sizeof(bl_prof.stats[id]));
+        bl_prof.stats[id].cycle_rate = bl_prof.cycle_rate;
+        bl_prof.stats[id].exec_min = UINT32_MAX;
+    }
+    k_spin_unlock(&bl_prof.lock, key);
+}
+
+/**
+ * @brief Peer asks for the profile of one of our rate groups
+ *
+ * The report goes out on the control lane ahead of the RPC response, so
+ * the caller has it when its call completes.
+ */
+static void bl_prof_query_handler(const bl_ipc_msg_t *msg, void *ctx)
+{
+    const bl_msg_prof_query_t *query = bl_msg_prof_query_decode(msg);
+    bl_msg_prof_report_t report = {0};
+    bl_osal_prof_stats_t stats;
+    bl_ipc_msg_t tx;
+    int ret;
+
+    ARG_UNUSED(ctx);
+
+    ret = bl_osal_prof_get_stats(query->thread_id, &stats);
+    if (ret == 0) {
+        report.thread_id = query->thread_id;
+        report.cycle_rate = stats.cycle_rate;
+        report.count = stats.count;
+        report.exec_min = stats.exec_min;
+        report.exec_max = stats.exec_max;
+        report.jitter_max = stats.jitter_max;
+        report.exec_total = stats.exec_total;
+        report.jitter_total = stats.jitter_total;
+        memcpy(report.exec_hist, stats.exec_hist, sizeof(report.exec_hist));
+        memcpy(report.jitter_hist, stats.jitter_hist, sizeof(report.jitter_hist));
+
+        bl_msg_prof_report_encode(&tx, &report);
+        ret = bl_ipc_send_msg(&tx);
+    }
+
+    bl_rpc_reply(msg, MIN(ret, 0));
+}
+
+/**
+ * @brief Profile report from the peer, kept for bl_osal_prof_query_peer()
+ */
+static void bl_prof_report_handler(const bl_ipc_msg_t *msg, void *ctx)
+{
+    const bl_msg_prof_report_t *report = bl_msg_prof_report_decode(msg);
+
+    ARG_UNUSED(ctx);
+
+    bl_prof_peer.cycle_rate = report->cycle_rate;
+    bl_prof_peer.count = report->count;
+    bl_prof_peer.exec_min = report->exec_min;
+    bl_prof_peer.exec_max = report->exec_max;
+    bl_prof_peer.exec_total = report->exec_total;
+    bl_prof_peer.jitter_max = report->jitter_max;
+    bl_prof_peer.jitter_total = report->jitter_total;
+    memcpy(bl_prof_peer.exec_hist, report->exec_hist, sizeof(bl_prof_peer.exec_hist));
+    memcpy(bl_prof_peer.jitter_hist, report->jitter_hist, sizeof(bl_prof_peer.jitter_hist));
+    bl_prof_peer_thread = report->thread_id;
+}
+
+/**
+ * @brief Get the profile of one rate group of the peer core
+ *
+ * Must not be called from the thread dispatching the control lane, which
+ * has to run the report and response handlers.
+ */
+int bl_osal_prof_query_peer(uint32_t thread_id, bl_osal_prof_stats_t *stats)
+{
+    bl_msg_prof_query_t query = {0};
+    bl_ipc_msg_t msg;
+    int ret;
+
+    if (thread_id >= BL_OS_MAX_NUM_THREADS || !stats) {
+        return -EINVAL;
+    }
+
+    k_mutex_lock(&bl_prof_peer_mutex, K_FOREVER);
+
+    bl_prof_peer_thread = -1;
+    query.thread_id = (uint8_t)thread_id;
+    bl_msg_prof_query_encode(&msg, &query);
+
+    ret = bl_rpc_call(&msg, K_MSEC(BL_PROF_QUERY_TIMEOUT_MS), NULL);
+    if (ret == 0 && bl_prof_peer_thread != (int)thread_id) {
+        ret = -EIO;
+    }
+    if (ret == 0) {
+        *stats = bl_prof_peer;
+    }
+
+    k_mutex_unlock(&bl_prof_peer_mutex);
+    return ret;
+}
+
+#if defined(CONFIG_SHELL)
+/**
+ * @brief Cycles to microseconds at the rate of a profile
+ */
+static uint32_t bl_prof_us(const bl_osal_prof_stats_t *stats, uint64_t cycles)
+{
+    return stats->cycle_rate ?
+           (uint32_t)MIN((cycles * USEC_PER_SEC) / stats->cycle_rate, UINT32_MAX) : 0U;
+}
+
+/**
+ * @brief Print one profile; with its histograms when detail is set
+ */
+static void bl_prof_print(const struct shell *sh, uint32_t id,
+                          const bl_osal_prof_stats_t *stats, bool detail)
+{
+    uint32_t jitter_count = 0;
+
+    for (uint32_t bin = 0; bin < BL_PROF_HIST_BINS; bin++) {
+        jitter_count += stats->jitter_hist[bin];
+    }
+
+    if (stats->count == 0U) {
+        if (detail) {
+            shell_print(sh, "%u: not run", id);
+        }
+        return;
+    }
+
+    shell_print(sh, "%u: %u runs, exec min/mean/max %u/%u/%u us, jitter mean/max %u/%u us",
+                id, stats->count,
+                bl_prof_us(stats, stats->exec_min),
+                bl_prof_us(stats, stats->exec_total / stats->count),
+                bl_prof_us(stats, stats->exec_max),
+                jitter_count ? bl_prof_us(stats, stats->jitter_total / jitter_count) : 0U,
+                bl_prof_us(stats, stats->jitter_max));
+
+    if (!detail) {
+        return;
+    }
+
+    shell_print(sh, "  %-14s %10s %10s", "cycles", "exec", "jitter");
+    for (uint32_t bin = 0; bin < BL_PROF_HIST_BINS; bin++) {
+        shell_print(sh, "  %s%-12u %10u %10u", (bin == BL_PROF_HIST_BINS - 1U) ? ">=" : "< ",
+                    (bin == BL_PROF_HIST_BINS - 1U) ? BIT(BL_PROF_HIST_SHIFT + bin - 1U) :
+                                                      BIT(BL_PROF_HIST_SHIFT + bin),
+                    stats->exec_hist[bin], stats->jitter_hist[bin]);
+    }
+}
+
+/**
+ * @brief Print the profiles of this core or of the peer
+ */
+static int bl_prof_cmd_print(const struct shell *sh, size_t argc, char **argv, bool peer)
+{
+    bl_osal_prof_stats_t stats;
+    uint32_t first = 0;
+    uint32_t last = BL_OS_MAX_NUM_THREADS - 1U;
+    int err = 0;
+    int ret;
+
+    if (argc > 1) {
+        first = (uint32_t)shell_strtoul(argv[1], 0, &err);
+        if (err != 0 || first >= BL_OS_MAX_NUM_THREADS) {
+            shell_error(sh, "Invalid thread ID: %s", argv[1]);
+            return -EINVAL;
+        }
+        last = first;
+    }
+
+    for (uint32_t id = first; id <= last; id++) {
+        ret = peer ? bl_osal_prof_query_peer(id, &stats) : bl_osal_prof_get_stats(id, &stats);
+        if (ret != 0) {
+            shell_error(sh, "%u: no profile (%d)", id, ret);
+            return ret;
+        }
+        bl_prof_print(sh, id, &stats, first == last);
+    }
+
+    return 0;
+}
+
+static int bl_prof_cmd_show(const struct shell *sh, size_t argc, char **argv)
+{
+    return bl_prof_cmd_print(sh, argc, argv, false);
+}
+
+static int bl_prof_cmd_peer(const struct shell *sh, size_t argc, char **argv)
+{
+    return bl_prof_cmd_print(sh, argc, argv, true);
+}
+
+static int bl_prof_cmd_reset(const struct shell *sh, size_t argc, char **argv)
+{
+    ARG_UNUSED(argc);
+    ARG_UNUSED(argv);
+
+    bl_osal_prof_reset();
+    shell_print(sh, "Profiles cleared");
+    return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(bl_prof_cmds,
+    SHELL_CMD_ARG(show, NULL, "Profile of this core [thread_id]", bl_prof_cmd_show, 1, 1),
+    SHELL_CMD_ARG(peer, NULL, "Profile of the other core [thread_id]", bl_prof_cmd_peer, 1, 1),
+    SHELL_CMD_ARG(reset, NULL, "Clear the profiles of this core", bl_prof_cmd_reset, 1, 0),
+    SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(prof, &bl_prof_cmds, "Rate group execution profiler", NULL);
+#endif /* CONFIG_SHELL */
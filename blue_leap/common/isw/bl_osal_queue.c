@@ -0,0 +1,237 @@
+/****
+* File Name    : bl_osal_queue.c
+* Version      : 1.0.0
+* Description  : OSAL queues over statically allocated storage. A by-value
+*                queue copies its items like a k_msgq. A by-reference queue
+*                owns a pool of records: the sender fills a record in place
+*                and only its pointer moves through the queue, so large
+*                records pass between tasks without being copied.
+* Creation Date: Oct 2026
+****/
+
+/****
+ * Includes
+ ****/
+#include "bl_zephyr_osal_cfg.h"
+#include <zephyr/logging/log.h>
+
+LOG_MODULE_REGISTER(bl_queue, LOG_LEVEL_INF);
+
+/****
+ * Static function prototypes
+ ****/
+static void bl_queue_count_send(bl_osal_queue_t *queue, int ret);
+static void bl_queue_count_recv(bl_osal_queue_t *queue, int ret);
+
+/****
+ * Function implementations
+ ****/
+
+/**
+ * @brief Initialize a queue defined with BL_OSAL_QUEUE_DEFINE
+ */
+int bl_osal_queue_init(bl_osal_queue_t *queue)
+{
+    const bl_osal_queue_cfg_t *cfg;
+    int ret = 0;
+
+    if (!queue || !queue->cfg || queue->cfg->length == 0U || queue->cfg->item_size == 0U) {
+        return -EINVAL;
+    }
+
+    cfg = queue->cfg;
+    memset(&queue->stats, 0, sizeof(queue->stats));
+
+    if (cfg->mode == BL_OSAL_QUEUE_BY_REF) {
+        k_msgq_init(&queue->msgq, cfg->ring, sizeof(void *), cfg->length);
+        ret = k_mem_slab_init(&queue->pool, cfg->pool,
+                              ROUND_UP(cfg->item_size, BL_OS_QUEUE_ALIGN), cfg->length);
+    } else {
+        k_msgq_init(&queue->msgq, cfg->ring, cfg->item_size, cfg->length);
+    }
+
+    if (ret != 0) {
+        LOG_ERR("Queue pool init failed: %d", ret);
+    }
+
+    return ret;
+}
+
+/**
+ * @brief Update the send counters and the depth high-water mark
+ */
+static void bl_queue_count_send(bl_osal_queue_t *queue, int ret)
+{
+    k_spinlock_key_t key = k_spin_lock(&queue->lock);
+
+    if (ret == 0) {
+        queue->stats.sent++;
+        queue->stats.depth_max = MAX(queue->stats.depth_max,
+                                     k_msgq_num_used_get(&queue->msgq));
+    } else if (ret == -EAGAIN) {
+        queue->stats.send_timeouts++;
+    }
+
+    k_spin_unlock(&queue->lock, key);
+}
+
+static void bl_queue_count_recv(bl_osal_queue_t *queue, int ret)
+{
+    k_spinlock_key_t key = k_spin_lock(&queue->lock);
+
+    if (ret == 0) {
+        queue->stats.received++;
+    } else if (ret == -EAGAIN) {
+        queue->stats.recv_timeouts++;
+    }
+
+    k_spin_unlock(&queue->lock, key);
+}
+
+/**
+ * @brief Copy an item into a by-value queue
+ * @return 0, -EAGAIN if the queue stayed full until the timeout
+ */
+int bl_osal_queue_send(bl_osal_queue_t *queue, const void *item, k_timeout_t timeout)
+{
+    int ret;
+
+    if (!queue || !item || queue->cfg->mode != BL_OSAL_QUEUE_BY_VALUE) {
+        return -EINVAL;
+    }
+
+    ret = k_msgq_put(&queue->msgq, item, timeout);
+    bl_queue_count_send(queue, ret);
+
+    return ret;
+}
+
+/**
+ * @brief Copy the oldest item out of a by-value queue
+ * @return 0, -EAGAIN if the queue stayed empty until the timeout
+ */
+int bl_osal_queue_recv(bl_osal_queue_t *queue, void *item, k_timeout_t timeout)
+{
+    int ret;
+
+    if (!queue || !item || queue->cfg->mode != BL_OSAL_QUEUE_BY_VALUE) {
+        return -EINVAL;
+    }
+
+    ret = k_msgq_get(&queue->msgq, item, timeout);
+    bl_queue_count_recv(queue, ret);
+
+    return ret;
+}
+
+/**
+ * @brief Take a record from the pool of a by-reference queue
+ *
+ * The pool holds as many records as the queue has entries, so a record
+ * that was allocated can always be sent: producers are held back here.
+ * @return 0, -EAGAIN if no record was freed until the timeout
+ */
+int bl_osal_queue_alloc(bl_osal_queue_t *queue, void **record, k_timeout_t timeout)
+{
+    k_spinlock_key_t key;
+    int ret;
+
+    if (!queue || !record || queue->cfg->mode != BL_OSAL_QUEUE_BY_REF) {
+        return -EINVAL;
+    }
+
+    ret = k_mem_slab_alloc(&queue->pool, record, timeout);
+
+    key = k_spin_lock(&queue->lock);
+    if (ret == 0) {
+        queue->stats.records++;
+        queue->stats.records_max = MAX(queue->stats.records_max, queue->stats.records);
+    } else {
+        *record = NULL;
+        queue->stats.alloc_failures++;
+        ret = -EAGAIN;
+    }
+    k_spin_unlock(&queue->lock, key);
+
+    return ret;
+}
+
+/**
+ * @brief Queue a record allocated from the same queue
+ *
+ * On success the record belongs to the receiver; the sender must not
+ * touch it anymore.
+ */
+int bl_osal_queue_send_ref(bl_osal_queue_t *queue, void *record, k_timeout_t timeout)
+{
+    int ret;
+
+    if (!queue || !record || queue->cfg->mode != BL_OSAL_QUEUE_BY_REF) {
+        return -EINVAL;
+    }
+
+    ret = k_msgq_put(&queue->msgq, &record, timeout);
+    bl_queue_count_send(queue, ret);
+
+    return ret;
+}
+
+/**
+ * @brief Take the oldest record of a by-reference queue
+ *
+ * The caller owns the record and returns it with bl_osal_queue_free().
+ * @return 0, -EAGAIN if the queue stayed empty until the timeout
+ */
+int bl_osal_queue_recv_ref(bl_osal_queue_t *queue, void **record, k_timeout_t timeout)
+{
+    int ret;
+
+    if (!queue || !record || queue->cfg->mode != BL_OSAL_QUEUE_BY_REF) {
+        return -EINVAL;
+    }
+
+    ret = k_msgq_get(&queue->msgq, record, timeout);
+    if (ret != 0) {
+        *record = NULL;
+    }
+    bl_queue_count_recv(queue, ret);
+
+    return ret;
+}
+
+/**
+ * @brief Return a record to the pool of its queue
+ */
+void bl_osal_queue_free(bl_osal_queue_t *queue, void *record)
+{
+    k_spinlock_key_t key;
+
+    if (!queue || !record || queue->cfg->mode != BL_OSAL_QUEUE_BY_REF) {
+        return;
+    }
+
+    k_mem_slab_free(&queue->pool, record);
+
+    key = k_spin_lock(&queue->lock);
+    queue->stats.records--;
+    k_spin_unlock(&queue->lock, key);
+}
+
+/**
+ * @brief Get the statistics of a queue
+ */
+int bl_osal_queue_get_stats(bl_osal_queue_t *queue, bl_osal_queue_stats_t *stats)
+{
+    k_spinlock_key_t key;
+
+    if (!queue || !stats) {
+        return -EINVAL;
+    }
+
+    key = k_spin_lock(&queue->lock);
+    *stats = queue->stats;
+    stats->depth = k_msgq_num_used_get(&queue->msgq);
+    k_spin_unlock(&queue->lock, key);
+
+    return 0;
+}
@@ -0,0 +1,328 @@
+/****
+* File Name    : bl_osal_stack.c
+* Version      : 1.0.0
+* Description  : Stack usage monitor. Every thread of the core is sampled
+*                periodically for its unused (still painted) stack and the
+*                peak usage is kept per thread, so that stacks can be sized
+*                from measurements. The peer core's figures are read with an
+*                RPC query.
+* Creation Date: Oct 2026
+****/
+
+/****
+ * Includes
+ ****/
+#include "bl_isw.h"
+#include "bl_zephyr_osal_cfg.h"
+#include <zephyr/logging/log.h>
+#if defined(CONFIG_SHELL)
+#include <zephyr/shell/shell.h>
+#endif
+
+LOG_MODULE_REGISTER(bl_stack, LOG_LEVEL_INF);
+
+/****
+ * Macro definitions
+ ****/
+#define BL_STACK_MONITOR_ENABLED \
+    (IS_ENABLED(CONFIG_INIT_STACKS) && IS_ENABLED(CONFIG_THREAD_STACK_INFO) && \
+     IS_ENABLED(CONFIG_THREAD_MONITOR))
+
+/****
+ * Typedef definitions
+ ****/
+
+/* Tracked thread */
+typedef struct {
+    const struct k_thread *thread;
+    bool warned;             /* Peak above BL_OS_STACK_WARN_PERCENT logged */
+    bl_osal_stack_info_t info;
+} bl_stack_entry_t;
+
+/****
+ * Global variables
+ ****/
+static struct {
+    struct k_spinlock lock;
+    uint32_t count;
+    bl_stack_entry_t entry[BL_OS_STACK_MAX_THREADS];
+} bl_stack;
+
+/* Latest stack report received from the peer, one query at a time */
+static K_MUTEX_DEFINE(bl_stack_peer_mutex);
+static bl_osal_stack_info_t bl_stack_peer;
+static volatile int bl_stack_peer_index = -1;
+static uint32_t bl_stack_peer_count;
+
+/****
+ * Static function prototypes
+ ****/
+static void bl_stack_sample_thread(const struct k_thread *thread, void *user_data);
+static void bl_stack_sample_work(struct k_work *work);
+static void bl_stack_query_handler(const bl_ipc_msg_t *msg, void *ctx);
+static void bl_stack_report_handler(const bl_ipc_msg_t *msg, void *ctx);
+
+static K_WORK_DELAYABLE_DEFINE(bl_stack_work, bl_stack_sample_work);
+
+/****
+ * Function implementations
+ ****/
+
+/**
+ * @brief Start periodic sampling and register the peer query handlers
+ */
+int bl_osal_stack_init(void)
+{
+    bl_ipc_register_handler(BL_MSG_TYPE_STACK_QUERY, bl_stack_query_handler, NULL);
+    bl_ipc_register_handler(BL_MSG_TYPE_STACK_REPORT, bl_stack_report_handler, NULL);
+
+    if (!BL_STACK_MONITOR_ENABLED) {
+        LOG_WRN("Stack monitor needs CONFIG_INIT_STACKS, THREAD_STACK_INFO and THREAD_MONITOR");
+        return -ENOTSUP;
+    }
+
+    k_work_schedule(&bl_stack_work, K_MSEC(BL_OS_STACK_SAMPLE_MS));
+    return 0;
+}
+
+/**
+ * @brief Update the peak stack usage of one thread
+ */
+static void bl_stack_sample_thread(const struct k_thread *thread, void *user_data)
+{
+#if BL_STACK_MONITOR_ENABLED
+    bl_stack_entry_t *entry = NULL;
+    k_spinlock_key_t key;
+    const char *name;
+    bool warn = false;
+    size_t unused;
+    uint32_t used;
+    uint32_t size;
+
+    ARG_UNUSED(user_data);
+
+    /* Scans the painted stack: done without holding any lock */
+    if (k_thread_stack_space_get(thread, &unused) != 0) {
+        return;
+    }
+
+    size = (uint32_t)thread->stack_info.size;
+    used = size - (uint32_t)unused;
+
+    key = k_spin_lock(&bl_stack.lock);
+    for (uint32_t i = 0; i < bl_stack.count; i++) {
+        if (bl_stack.entry[i].thread == thread) {
+            entry = &bl_stack.entry[i];
+            break;
+        }
+    }
+
+    if (!entry && bl_stack.count < BL_OS_STACK_MAX_THREADS) {
+        entry = &bl_stack.entry[bl_stack.count++];
+        entry->thread = thread;
+        name = k_thread_name_get((k_tid_t)thread);
+        if (name && name[0] != '\0') {
+            strncpy(entry->info.name, name, sizeof(entry->info.name) - 1U);
+        } else {
+            snprintk(entry->info.name, sizeof(entry->info.name), "%p", thread);
+        }
+    }
+
+    if (entry) {
+        entry->info.size = size;
+        entry->info.peak = MAX(entry->info.peak, used);
+        warn = !entry->warned &&
+               ((uint64_t)used * 100U >= (uint64_t)size * BL_OS_STACK_WARN_PERCENT);
+        entry->warned |= warn;
+    }
+    k_spin_unlock(&bl_stack.lock, key);
+
+    if (warn) {
+        LOG_WRN("Thread %s uses %u of %u stack bytes", entry->info.name, used, size);
+    }
+#else
+    ARG_UNUSED(thread);
+    ARG_UNUSED(user_data);
+#endif
+}
+
+/**
+ * @brief Sample the stack usage of every thread of this core
+ */
+void bl_osal_stack_sample(void)
+{
+#if BL_STACK_MONITOR_ENABLED
+    k_thread_foreach_unlocked(bl_stack_sample_thread, NULL);
+#endif
+}
+
+static void bl_stack_sample_work(struct k_work *work)
+{
+    bl_osal_stack_sample();
+    k_work_schedule(k_work_delayable_from_work(work), K_MSEC(BL_OS_STACK_SAMPLE_MS));
+}
+
+/**
+ * @brief Get the stack usage of the index-th tracked thread
+ * @return Number of threads tracked, negative errno if index is not one of them
+ */
+int bl_osal_stack_get(uint32_t index, bl_osal_stack_info_t *info)
+{
+    k_spinlock_key_t key;
+    int ret;
+
+    if (!info) {
+        return -EINVAL;
+    }
+
+    key = k_spin_lock(&bl_stack.lock);
+    if (index < bl_stack.count) {
+        *info = bl_stack.entry[index].info;
+        ret = (int)bl_stack.count;
+    } else {
+        ret = -ENOENT;
+    }
+    k_spin_unlock(&bl_stack.lock, key);
+
+    return ret;
+}
+
+/**
+ * @brief Peer asks for the stack usage of one of our threads
+ *
+ * The report goes out on the control lane ahead of the RPC response.
+ */
+static void bl_stack_query_handler(const bl_ipc_msg_t *msg, void *ctx)
+{
+    const bl_msg_stack_query_t *query = bl_msg_stack_query_decode(msg);
+    bl_msg_stack_report_t report = {0};
+    bl_osal_stack_info_t info;
+    bl_ipc_msg_t tx;
+    int ret;
+
+    ARG_UNUSED(ctx);
+
+    ret = bl_osal_stack_get(query->index, &info);
+    if (ret > 0) {
+        report.index = query->index;
+        report.count = (uint8_t)ret;
+        report.size = info.size;
+        report.peak = info.peak;
+        memcpy(report.name, info.name, sizeof(report.name));
+
+        bl_msg_stack_report_encode(&tx, &report);
+        ret = bl_ipc_send_msg(&tx);
+    }
+
+    bl_rpc_reply(msg, MIN(ret, 0));
+}
+
+/**
+ * @brief Stack report from the peer, kept for bl_osal_stack_query_peer()
+ */
+static void bl_stack_report_handler(const bl_ipc_msg_t *msg, void *ctx)
+{
+    const bl_msg_stack_report_t *report = bl_msg_stack_report_decode(msg);
+
+    ARG_UNUSED(ctx);
+
+    memcpy(bl_stack_peer.name, report->name, sizeof(bl_stack_peer.name));
+    bl_stack_peer.name[sizeof(bl_stack_peer.name) - 1U] = '\0';
+    bl_stack_peer.size = report->size;
+    bl_stack_peer.peak = report->peak;
+    bl_stack_peer_count = report->count;
+    bl_stack_peer_index = report->index;
+}
+
+/**
+ * @brief Get the stack usage of the index-th thread tracked by the peer
+ *
+ * Must not be called from the thread dispatching the control lane.
+ * @return Number of threads tracked by the peer, negative errno on failure
+ */
+int bl_osal_stack_query_peer(uint32_t index, bl_osal_stack_info_t *info)
+{
+    bl_msg_stack_query_t query = {0};
+    bl_ipc_msg_t msg;
+    int ret;
+
+    if (index >= BL_OS_STACK_MAX_THREADS || !info) {
+        return -EINVAL;
+    }
+
+    k_mutex_lock(&bl_stack_peer_mutex, K_FOREVER);
+
+    bl_stack_peer_index = -1;
+    query.index = (uint8_t)index;
+    bl_msg_stack_query_encode(&msg, &query);
+
+    ret = bl_rpc_call(&msg, K_MSEC(BL_PROF_QUERY_TIMEOUT_MS), NULL);
+    if (ret == 0 && bl_stack_peer_index != (int)index) {
+        ret = -EIO;
+    }
+    if (ret == 0) {
+        *info = bl_stack_peer;
+        ret = (int)bl_stack_peer_count;
+    }
+
+    k_mutex_unlock(&bl_stack_peer_mutex);
+    return ret;
+}
+
+#if defined(CONFIG_SHELL)
+/**
+ * @brief Print the stack usage of every thread of this core or of the peer
+ */
+static int bl_stack_cmd_print(const struct shell *sh, bool peer)
+{
+    bl_osal_stack_info_t info;
+    uint32_t index = 0;
+    int count;
+
+    if (!peer) {
+        bl_osal_stack_sample();
+    }
+
+    shell_print(sh, "%-16s %8s %8s %5s", "thread", "size", "peak", "use");
+
+    do {
+        count = peer ? bl_osal_stack_query_peer(index, &info) : bl_osal_stack_get(index, &info);
+        if (count < 0) {
+            if (index == 0U) {
+                shell_error(sh, "No stack figures (%d)", count);
+            }
+            return (index == 0U) ? count : 0;
+        }
+
+        shell_print(sh, "%-16s %8u %8u %4u%%", info.name, info.size, info.peak,
+                    info.size ? (info.peak * 100U) / info.size : 0U);
+        index++;
+    } while (index < (uint32_t)count);
+
+    return 0;
+}
+
+static int bl_stack_cmd_show(const struct shell *sh, size_t argc, char **argv)
+{
+    ARG_UNUSED(argc);
+    ARG_UNUSED(argv);
+
+    return bl_stack_cmd_print(sh, false);
+}
+
+static int bl_stack_cmd_peer(const struct shell *sh, size_t argc, char **argv)
+{
+    ARG_UNUSED(argc);
+    ARG_UNUSED(argv);
+
+    return bl_stack_cmd_print(sh, true);
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(bl_stack_cmds,
+    SHELL_CMD_ARG(show, NULL, "Peak stack usage of the threads of this core", bl_stack_cmd_show, 1, 0),
+    SHELL_CMD_ARG(peer, NULL, "Peak stack usage of the threads of the other core", bl_stack_cmd_peer, 1, 0),
+    SHELL_SUBCMD_SET_END
+);
+
+SHELL_CMD_REGISTER(stack, &bl_stack_cmds, "Thread stack usage monitor", NULL);
+#endif /* CONFIG_SHELL */
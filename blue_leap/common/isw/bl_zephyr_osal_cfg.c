@@ -10,8 +10,13 @@
  ****/
 #include "bl_zephyr_osal_cfg.h"
 #include "bl_isw.h"
+#include "bl_ipc_stream.h"
+#include "bl_ipc_mailbox.h"
+#include "common.h"
 #include <zephyr/logging/log.h>
 #include <zephyr/ipc/ipc_service.h>
+#include <zephyr/drivers/mbox.h>
+#include <zephyr/cache.h>
 
 LOG_MODULE_REGISTER(bl_osal, LOG_LEVEL_INF);
 
@@ -21,33 +26,333 @@ LOG_MODULE_REGISTER(bl_osal, LOG_LEVEL_INF);
 bl_osal_context_t g_osal_context = {0};
 bl_system_status_t g_system_status = {0};
 
-/* IPC endpoint for inter-core communication */
-static struct ipc_ept bl_ipc_ept;
-static K_SEM_DEFINE(bl_ipc_bound_sem, 0, 1);
+/* IPC endpoints for inter-core communication, one per lane */
+static struct ipc_ept bl_ipc_ept[BL_IPC_LANE_MAX];
+static K_SEM_DEFINE(bl_ipc_bound_sem, 0, BL_IPC_LANE_MAX);
 
-/* Thread stacks */
-K_THREAD_STACK_ARRAY_DEFINE(bl_thread_stacks, BL_OS_MAX_NUM_THREADS, BL_THREAD_STACK_SIZE_LARGE);
-static struct k_thread bl_thread_data[BL_OS_MAX_NUM_THREADS];
+/* IPC transmit statistics */
+static bl_ipc_tx_stats_t bl_ipc_tx_stats;
+static struct k_spinlock bl_ipc_stats_lock;
+
+/* Core this image runs on, indexes the flow control blocks. A loopback
+ * build is a single image acting as both cores, so it is its own peer.
+ */
+#if defined(BL_IPC_LOOPBACK)
+#define BL_IPC_CORE_LOCAL   BL_IPC_CORE_M7
+#define BL_IPC_CORE_PEER    BL_IPC_CORE_M7
+#elif defined(CORE_CM7)
+#define BL_IPC_CORE_LOCAL   BL_IPC_CORE_M7
+#define BL_IPC_CORE_PEER    BL_IPC_CORE_M4
+#else
+#define BL_IPC_CORE_LOCAL   BL_IPC_CORE_M4
+#define BL_IPC_CORE_PEER    BL_IPC_CORE_M7
+#endif
+
+/* Per-type counter update, field is a member of bl_ipc_type_stats_t */
+#define BL_IPC_TYPE_COUNT(type, field) \
+    bl_ipc_type_count((type), offsetof(bl_ipc_type_stats_t, field))
+
+/* Flow control block of one core in shared memory, written only by that core */
+typedef struct {
+    /* Records taken off (or dropped from) each RX lane: the credits returned */
+    volatile uint32_t consumed[BL_IPC_LANE_MAX];
+    uint8_t reserved[BL_CACHE_LINE_SIZE - (BL_IPC_LANE_MAX * sizeof(uint32_t))];
+    bl_ipc_type_stats_t stats[BL_MSG_TYPE_MAX];
+} __aligned(BL_CACHE_LINE_SIZE) bl_ipc_flow_blk_t;
+
+typedef struct {
+    bl_ipc_flow_blk_t core[BL_IPC_CORE_MAX];
+} bl_ipc_flow_shm_t;
+
+BUILD_ASSERT(sizeof(bl_ipc_flow_shm_t) <= BL_SHM_IPC_FLOW_SIZE,
+             "IPC flow control block does not fit its shared-memory area");
+
+/* Start of the shared data region, set once the IPC instance is open */
+static uintptr_t bl_ipc_shm_base;
+
+static bl_ipc_flow_shm_t *bl_ipc_flow_shm;
+
+/* Records sent per lane; the peer's consumed count is subtracted to get credits */
+static uint32_t bl_ipc_credit_sent[BL_IPC_LANE_MAX];
+
+/* Received vring buffer held until all of its records are released */
+typedef struct {
+    atomic_t refs;       /* Queued records plus the receive callback; 0 = free */
+    void *buf;
+    uint32_t lane;
+} bl_ipc_rx_hold_t;
+
+static bl_ipc_rx_hold_t bl_ipc_rx_holds[BL_IPC_RX_HOLD_SLOTS];
+
+/* Registered message handlers and their statistics, indexed by type */
+static struct {
+    bl_ipc_handler_t handler;
+    void *ctx;
+} bl_ipc_handlers[BL_MSG_TYPE_MAX];
+static bl_ipc_handler_stats_t bl_ipc_handler_stats[BL_MSG_TYPE_MAX];
+
+/* Per-lane transmit batch used for message coalescing */
+typedef struct {
+    struct k_mutex lock;
+    struct k_work_delayable flush_work;
+    uint32_t lane;
+    uint8_t *buf;        /* Borrowed vring buffer, NULL when none is held */
+    uint32_t size;       /* Capacity of buf */
+    uint32_t used;       /* End of the last record in buf */
+} bl_ipc_batch_t;
+
+static bl_ipc_batch_t bl_ipc_batch[BL_IPC_LANE_MAX];
+
+/* Inter-core sample streams */
+static bl_stream_t bl_ipc_streams[BL_IPC_STREAM_MAX];
+
+#ifdef BL_SHARED_DATA_LOCAL
+/* Without a shared data region the areas below live in local RAM */
+uint8_t bl_shared_data[BL_SHARED_DATA_SIZE] __aligned(BL_CACHE_LINE_SIZE);
+#endif
+
+/* IPC service instance: the "bl,ipc" chosen node when set, MU1 otherwise */
+#if DT_HAS_CHOSEN(bl_ipc)
+#define BL_IPC_INSTANCE_NODE    DT_CHOSEN(bl_ipc)
+#else
+#define BL_IPC_INSTANCE_NODE    DT_NODELABEL(mu1)
+#endif
+
+/* Inter-core latest-value mailboxes */
+static bl_mailbox_t bl_ipc_mailboxes[BL_IPC_MAILBOX_MAX];
+
+#if DT_NODE_HAS_PROP(DT_PATH(zephyr_user), mboxes)
+/* MU channel used as stream doorbell (M4 sends, M7 receives) */
+static const struct mbox_dt_spec bl_ipc_stream_mbox =
+    MBOX_DT_SPEC_GET(DT_PATH(zephyr_user), stream);
+#define BL_IPC_STREAM_HAS_DOORBELL 1
+#endif
+
+/* 64-bit extension of the 32-bit cycle counter */
+static struct k_spinlock bl_time_lock;
+static uint32_t bl_time_last_cycles;
+static uint64_t bl_time_high_cycles;
+static struct k_timer bl_time_wrap_timer;
+
+/* Keeps the counter sampled well within one wrap period (7 s at 600 MHz) */
+#define BL_TIME_WRAP_CHECK_MS    1000
+
+/* M4 estimate of the M7 clock: shared = local + offset + drift since base,
+ * plus the part of the slew applied so far
+ */
+static struct {
+    struct k_spinlock lock;
+    int64_t offset_us;
+    uint64_t base_us;               /* Local time the offset was measured at */
+    int32_t drift_ppb;
+    int64_t slew_us;                /* Correction still being applied from base_us */
+    int64_t est_offset_us;          /* Last window estimate, for the drift */
+    uint64_t est_local_us;
+    uint64_t last_shared_us;        /* Latest time handed out, never goes back */
+    uint32_t seq;                   /* Sequence number of the last request */
+    uint32_t window;                /* Replies in the current window */
+    uint32_t best_rtt_us;           /* Best sample of the current window */
+    int64_t best_offset_us;
+    uint64_t best_local_us;
+    bl_time_sync_stats_t stats;
+} bl_time_sync;
+
+#ifdef CORE_CM4
+static void bl_time_sync_work_handler(struct k_work *work);
+static K_WORK_DELAYABLE_DEFINE(bl_time_sync_work, bl_time_sync_work_handler);
+#endif
+
+#if defined(CORE_CM7) && !defined(BL_IPC_LOOPBACK)
+/* Reply to the last request, sent from the system workqueue: the IPC RX
+ * callback must not send
+ */
+static void bl_time_sync_reply_handler(struct k_work *work);
+static K_WORK_DEFINE(bl_time_sync_reply_work, bl_time_sync_reply_handler);
+static bl_msg_time_sync_t bl_time_sync_reply;
+#endif
+
+/* Thread stacks: one per rate group, sized from the rate group table, or
+ * a single one for the cyclic executive
+ */
+#define BL_THREAD_STACK_DEFINE(ID, period, offset, prio, stack_size, ...) \
+    static K_THREAD_STACK_DEFINE(bl_thread_stack_##ID, stack_size);
+
+#define BL_THREAD_STACK_ENTRY(ID, ...) \
+    [BL_OS_THREAD_##ID##_ID] = { \
+        .stack = bl_thread_stack_##ID, \
+        .size = K_THREAD_STACK_SIZEOF(bl_thread_stack_##ID), \
+    },
+
+#if BL_OS_EXEC_CYCLIC
+static K_THREAD_STACK_DEFINE(bl_thread_stack_cyclic, BL_OS_EXEC_CYCLIC_STACK_SIZE);
+#else
+BL_OS_RATE_GROUP_TABLE(BL_THREAD_STACK_DEFINE)
+#endif
+
+static const struct {
+    k_thread_stack_t *stack;
+    size_t size;
+} bl_thread_stacks[BL_OS_NUM_OSAL_THREADS] = {
+#if BL_OS_EXEC_CYCLIC
+    [BL_OS_THREAD_INIT_ID] = {
+        .stack = bl_thread_stack_cyclic,
+        .size = K_THREAD_STACK_SIZEOF(bl_thread_stack_cyclic),
+    },
+#else
+    BL_OS_RATE_GROUP_TABLE(BL_THREAD_STACK_ENTRY)
+#endif
+};
+static struct k_thread bl_thread_data[BL_OS_NUM_OSAL_THREADS];
 
 /****
  * Static function prototypes
  ****/
 static void bl_ipc_bound_cb(void *priv);
 static void bl_ipc_recv_cb(const void *data, size_t len, void *priv);
+static void bl_ipc_account_tx(bl_ipc_tx_path_stats_t *path, uint32_t msgs,
+                              uint32_t copied, uint32_t sent, uint32_t cycles);
+static int bl_ipc_encode(const bl_ipc_msg_t *msg);
+static int bl_ipc_validate(const void *data, size_t len);
+static bool bl_ipc_payload_valid(const bl_ipc_msg_t *msg);
+static bl_ipc_rx_hold_t* bl_ipc_rx_hold_get(uint32_t lane, const void *data);
+static void bl_ipc_rx_unref(bl_ipc_rx_hold_t *hold);
+static int bl_osal_ipc_stream_init(void);
+static int bl_osal_ipc_mailbox_init(void);
+static void bl_osal_ipc_flow_init(void);
+static int bl_ipc_credit_take(uint32_t msg_type, uint32_t lane, k_timeout_t timeout);
+static void bl_ipc_credit_refund(uint32_t lane);
+static void bl_ipc_credit_return(uint32_t lane, uint32_t count);
+static void bl_ipc_type_count(uint32_t msg_type, size_t counter);
+static void bl_ipc_batch_flush_work(struct k_work *work);
+static uint64_t bl_time_cycles(void);
+static void bl_time_wrap_handler(struct k_timer *timer);
+static void bl_time_sync_rx(const bl_ipc_msg_t *msg, uint64_t rx_local_us);
 
 /****
  * Static variables
  ****/
-static struct ipc_ept_cfg bl_ipc_ept_cfg = {
-    .name = "bl_ipc",
-    .cb = {
-        .bound = bl_ipc_bound_cb,
-        .received = bl_ipc_recv_cb,
+
+/* Queues of received message descriptors, one per lane */
+K_MSGQ_DEFINE(bl_ipc_alarm_msgq, sizeof(bl_ipc_rx_desc_t), BL_IPC_ALARM_QUEUE_SIZE, 4);
+K_MSGQ_DEFINE(bl_ipc_control_msgq, sizeof(bl_ipc_rx_desc_t), BL_IPC_CONTROL_QUEUE_SIZE, 4);
+K_MSGQ_DEFINE(bl_ipc_bulk_msgq, sizeof(bl_ipc_rx_desc_t), BL_IPC_BULK_QUEUE_SIZE, 4);
+
+static struct k_msgq *const bl_ipc_rx_msgq[BL_IPC_LANE_MAX] = {
+    [BL_IPC_LANE_ALARM]   = &bl_ipc_alarm_msgq,
+    [BL_IPC_LANE_CONTROL] = &bl_ipc_control_msgq,
+    [BL_IPC_LANE_BULK]    = &bl_ipc_bulk_msgq,
+};
+
+/* Endpoint configuration per lane; priv carries the lane number */
+static struct ipc_ept_cfg bl_ipc_ept_cfg[BL_IPC_LANE_MAX] = {
+    [BL_IPC_LANE_ALARM] = {
+        .name = "bl_ipc_alarm",
+        .prio = 0,
+        .cb = {
+            .bound = bl_ipc_bound_cb,
+            .received = bl_ipc_recv_cb,
+        },
+        .priv = UINT_TO_POINTER(BL_IPC_LANE_ALARM),
+    },
+    [BL_IPC_LANE_CONTROL] = {
+        .name = "bl_ipc_ctrl",
+        .prio = 1,
+        .cb = {
+            .bound = bl_ipc_bound_cb,
+            .received = bl_ipc_recv_cb,
+        },
+        .priv = UINT_TO_POINTER(BL_IPC_LANE_CONTROL),
+    },
+    [BL_IPC_LANE_BULK] = {
+        .name = "bl_ipc_bulk",
+        .prio = 2,
+        .cb = {
+            .bound = bl_ipc_bound_cb,
+            .received = bl_ipc_recv_cb,
+        },
+        .priv = UINT_TO_POINTER(BL_IPC_LANE_BULK),
+    },
+};
+
+/* RX queue depth of each lane, which is also the credit count of its sender */
+static const uint16_t bl_ipc_lane_depth[BL_IPC_LANE_MAX] = {
+    [BL_IPC_LANE_ALARM]   = BL_IPC_ALARM_QUEUE_SIZE,
+    [BL_IPC_LANE_CONTROL] = BL_IPC_CONTROL_QUEUE_SIZE,
+    [BL_IPC_LANE_BULK]    = BL_IPC_BULK_QUEUE_SIZE,
+};
+
+/* Lanes whose messages are coalesced; alarms and control go out at once */
+static const bool bl_ipc_lane_coalesce[BL_IPC_LANE_MAX] = {
+    [BL_IPC_LANE_ALARM]   = false,
+    [BL_IPC_LANE_CONTROL] = false,
+    [BL_IPC_LANE_BULK]    = true,
+};
+
+/* Shared-memory area (offset in the shared data region) and sample size
+ * of each stream
+ */
+static const struct {
+    uintptr_t shm_offset;
+    size_t shm_size;
+    uint32_t elem_size;
+} bl_ipc_stream_cfg[BL_IPC_STREAM_MAX] = {
+    [BL_IPC_STREAM_ADC] = {
+        .shm_offset = BL_SHM_STREAM_ADC_OFFSET,
+        .shm_size = BL_SHM_STREAM_ADC_SIZE,
+        .elem_size = sizeof(bl_adc_sample_t),
     },
 };
 
-/* Message queue for received IPC messages */
-K_MSGQ_DEFINE(bl_ipc_rx_msgq, sizeof(bl_ipc_msg_t), BL_IPC_MSG_QUEUE_SIZE, 4);
+/* Shared-memory area (offset in the shared data region) and value size
+ * of each mailbox
+ */
+static const struct {
+    uintptr_t shm_offset;
+    size_t shm_size;
+    uint32_t size;
+} bl_ipc_mailbox_cfg[BL_IPC_MAILBOX_MAX] = {
+    [BL_IPC_MAILBOX_SENSOR] = {
+        .shm_offset = BL_SHM_MAILBOX_SENSOR_OFFSET,
+        .shm_size = BL_SHM_MAILBOX_SENSOR_SIZE,
+        .size = sizeof(bl_sensor_data_t),
+    },
+};
+
+/* What a sender does when the peer has no free RX slot for a message type */
+typedef enum {
+    BL_IPC_FLOW_BLOCK = 0,   /* Wait for a credit, up to the caller's timeout */
+    BL_IPC_FLOW_DROP,        /* Drop at once; the next message supersedes it */
+} bl_ipc_flow_policy_t;
+
+/* Per-type tables, generated from the message registry (bl_ipc_msg_def.h) */
+#define BL_IPC_MSG_LANE(NAME, name, lane, ...)          [BL_MSG_TYPE_##NAME] = BL_IPC_LANE_##lane,
+#define BL_IPC_MSG_POLICY(NAME, name, lane, policy, ...) [BL_MSG_TYPE_##NAME] = BL_IPC_FLOW_##policy,
+#define BL_IPC_MSG_SIZE(NAME, name, lane, policy, size) [BL_MSG_TYPE_##NAME] = (size),
+#define BL_IPC_MSG_SIZE_ANY(NAME, ...)                  [BL_MSG_TYPE_##NAME] = BL_IPC_MSG_LEN_ANY,
+#define BL_IPC_MSG_SIZE_CHECK(NAME, name, ...) \
+    BUILD_ASSERT(sizeof(bl_msg_##name##_t) <= BL_IPC_MSG_MAX_SIZE, "bl_msg_" #name "_t too large");
+
+/* Payload length of variable-size messages is only bounded by BL_IPC_MSG_MAX_SIZE */
+#define BL_IPC_MSG_LEN_ANY    UINT16_MAX
+
+BL_IPC_MSG_TABLE(BL_IPC_MSG_SIZE_CHECK)
+
+/* Lane assignment of each message type */
+static const uint8_t bl_ipc_msg_lane[BL_MSG_TYPE_MAX] = {
+    BL_IPC_MSG_TABLE(BL_IPC_MSG_LANE)
+    BL_IPC_MSG_RAW_TABLE(BL_IPC_MSG_LANE)
+};
+
+static const uint8_t bl_ipc_msg_policy[BL_MSG_TYPE_MAX] = {
+    BL_IPC_MSG_TABLE(BL_IPC_MSG_POLICY)
+    BL_IPC_MSG_RAW_TABLE(BL_IPC_MSG_POLICY)
+};
+
+/* Payload length of each message type */
+static const uint16_t bl_ipc_msg_len[BL_MSG_TYPE_MAX] = {
+    BL_IPC_MSG_TABLE(BL_IPC_MSG_SIZE)
+    BL_IPC_MSG_RAW_TABLE(BL_IPC_MSG_SIZE_ANY)
+};
 
 /****
  * Function implementations
@@ -64,17 +369,165 @@ static void bl_ipc_bound_cb(void *priv)
 
 /**
  * @brief IPC receive callback
+ *
+ * The vring buffer is held rather than copied: each record in it is queued
+ * as a descriptor pointing into the buffer, and the buffer goes back to the
+ * peer once the last descriptor has been released.
  */
-static void bl_ipc_recv_cb(const void *data, size_t len, void *priv)
+static BL_HOT_CODE void bl_ipc_recv_cb(const void *data, size_t len, void *priv)
 {
-    bl_ipc_msg_t msg;
+    uint32_t lane = POINTER_TO_UINT(priv);
+    const uint8_t *rec = (const uint8_t *)data;
+    bl_ipc_rx_hold_t *hold;
+    bl_ipc_rx_desc_t desc;
+    uint64_t rx_local_us = bl_osal_get_local_time_us();
+    uint32_t dropped = 0;
+    bool queued;
+    int rec_len;
 
-    if (len <= sizeof(bl_ipc_msg_t)) {
-        memcpy(&msg, data, len);
-        k_msgq_put(&bl_ipc_rx_msgq, &msg, K_NO_WAIT);
-    } else {
-        LOG_ERR("Received IPC message too large: %zu bytes", len);
+    hold = bl_ipc_rx_hold_get(lane, data);
+    desc.hold = hold;
+
+    /* A buffer carries one or more records, each starting 8-byte aligned */
+    while (len >= BL_IPC_MSG_HDR_SIZE) {
+        rec_len = bl_ipc_validate(rec, len);
+        if (rec_len < 0) {
+            LOG_ERR("Malformed IPC record: %zu bytes left", len);
+            break;
+        }
+
+        desc.msg = (const bl_ipc_msg_t *)rec;
+        queued = false;
+        if (!bl_ipc_payload_valid(desc.msg)) {
+            LOG_WRN("IPC message type %u with bad length %u", desc.msg->msg_type,
+                    desc.msg->data_len);
+        } else if (desc.msg->msg_type == BL_MSG_TYPE_TIME_SYNC) {
+            /* Timestamped here, as close to the arrival time as possible */
+            bl_time_sync_rx(desc.msg, rx_local_us);
+            queued = true;
+            bl_ipc_credit_return(lane, 1U);
+        } else if (hold) {
+            atomic_inc(&hold->refs);
+            queued = (k_msgq_put(bl_ipc_rx_msgq[lane], &desc, K_NO_WAIT) == 0);
+            if (!queued) {
+                atomic_dec(&hold->refs);
+            }
+        }
+
+        if (queued) {
+            BL_IPC_TYPE_COUNT(desc.msg->msg_type, received);
+        } else {
+            /* Hand the credit back so the sender does not stall on it */
+            BL_IPC_TYPE_COUNT(desc.msg->msg_type, dropped);
+            bl_ipc_credit_return(lane, 1U);
+            dropped++;
+        }
+
+        rec_len = MIN(ROUND_UP(rec_len, BL_IPC_RECORD_ALIGN), len);
+        rec += rec_len;
+        len -= rec_len;
+    }
+
+    if (dropped > 0) {
+        LOG_WRN("IPC RX dropped %u messages on lane %u", dropped, lane);
+    }
+
+    /* Drop the reference taken for the callback itself */
+    if (hold) {
+        bl_ipc_rx_unref(hold);
+    }
+}
+
+/**
+ * @brief Take a free hold slot for a received buffer and hold the buffer
+ * @return Slot with one reference owned by the caller, NULL if none is free
+ */
+static BL_HOT_CODE bl_ipc_rx_hold_t* bl_ipc_rx_hold_get(uint32_t lane, const void *data)
+{
+    bl_ipc_rx_hold_t *hold;
+    int ret;
+
+    for (uint32_t i = 0; i < BL_IPC_RX_HOLD_SLOTS; i++) {
+        hold = &bl_ipc_rx_holds[i];
+        if (!atomic_cas(&hold->refs, 0, 1)) {
+            continue;
+        }
+
+        hold->buf = (void *)data;
+        hold->lane = lane;
+
+        ret = bl_osal_ipc_hold_rx_buffer(lane, data);
+        if (ret < 0) {
+            LOG_ERR("Failed to hold IPC RX buffer: %d", ret);
+            atomic_set(&hold->refs, 0);
+            return NULL;
+        }
+
+        return hold;
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Drop one reference to a held buffer, releasing it on the last one
+ */
+static BL_HOT_CODE void bl_ipc_rx_unref(bl_ipc_rx_hold_t *hold)
+{
+    /* The slot may be reused as soon as the count reaches zero */
+    void *buf = hold->buf;
+    uint32_t lane = hold->lane;
+
+    if (atomic_dec(&hold->refs) == 1) {
+        bl_osal_ipc_release_rx_buffer(lane, buf);
+    }
+}
+
+/**
+ * @brief Validate a message and return its wire length
+ */
+static int bl_ipc_encode(const bl_ipc_msg_t *msg)
+{
+    if (msg->msg_type >= BL_MSG_TYPE_MAX || msg->data_len > BL_IPC_MSG_MAX_SIZE ||
+        !bl_ipc_payload_valid(msg)) {
+        return -EINVAL;
+    }
+
+    return BL_IPC_MSG_WIRE_SIZE(msg);
+}
+
+/**
+ * @brief Check the payload length of a message against its registered type
+ *
+ * Done once, when a message is sent and when it is received, so that
+ * consumers can use bl_msg_<name>_decode() without any further check.
+ */
+static BL_HOT_CODE bool bl_ipc_payload_valid(const bl_ipc_msg_t *msg)
+{
+    uint16_t len = bl_ipc_msg_len[msg->msg_type];
+
+    return (len == BL_IPC_MSG_LEN_ANY) || (msg->data_len == len);
+}
+
+/**
+ * @brief Check one compact wire record in place
+ * @return Length of the record on the wire, negative if malformed
+ */
+static BL_HOT_CODE int bl_ipc_validate(const void *data, size_t len)
+{
+    const bl_ipc_msg_t *msg = (const bl_ipc_msg_t *)data;
+
+    if (len < BL_IPC_MSG_HDR_SIZE) {
+        return -EMSGSIZE;
+    }
+
+    /* The header must not describe more bytes than were received */
+    if (msg->msg_type >= BL_MSG_TYPE_MAX || msg->data_len > BL_IPC_MSG_MAX_SIZE ||
+        BL_IPC_MSG_WIRE_SIZE(msg) > len) {
+        return -EBADMSG;
     }
+
+    return BL_IPC_MSG_WIRE_SIZE(msg);
 }
 
 /**
@@ -96,11 +549,25 @@ int bl_osal_init(void)
     g_osal_context.active_threads = 0;
     g_osal_context.initialized = true;
 
+    bl_osal_buf_init();
+    bl_osal_prof_init();
+    bl_osal_stack_init();
+
+    if (!IS_ENABLED(CONFIG_TIMER_HAS_64BIT_CYCLE_COUNTER)) {
+        k_timer_init(&bl_time_wrap_timer, bl_time_wrap_handler, NULL);
+        k_timer_start(&bl_time_wrap_timer, K_MSEC(BL_TIME_WRAP_CHECK_MS),
+                      K_MSEC(BL_TIME_WRAP_CHECK_MS));
+    }
+
     return 0;
 }
 
 /**
  * @brief Create a thread
+ *
+ * The entry function receives the thread ID as its first argument. The
+ * thread runs on the static stack of its ID, which must be at least
+ * config->stack_size bytes.
  */
 int bl_osal_create_thread(bl_thread_config_t *config, k_thread_entry_t entry)
 {
@@ -113,12 +580,19 @@ int bl_osal_create_thread(bl_thread_config_t *config, k_thread_entry_t entry)
         return -EEXIST;
     }
 
+    if (config->thread_id >= BL_OS_NUM_OSAL_THREADS ||
+        !bl_thread_stacks[config->thread_id].stack ||
+        bl_thread_stacks[config->thread_id].size < config->stack_size) {
+        LOG_ERR("No stack of %u bytes for thread %u", config->stack_size, config->thread_id);
+        return -ENOMEM;
+    }
+
     g_osal_context.thread_handles[config->thread_id] = k_thread_create(
         &bl_thread_data[config->thread_id],
-        bl_thread_stacks[config->thread_id],
-        config->stack_size,
+        bl_thread_stacks[config->thread_id].stack,
+        bl_thread_stacks[config->thread_id].size,
         entry,
-        NULL, NULL, NULL,
+        UINT_TO_POINTER(config->thread_id), NULL, NULL,
         config->priority,
         0,
         K_NO_WAIT
@@ -175,6 +649,73 @@ int bl_osal_delay_ms(uint32_t ms)
     return 0;
 }
 
+/**
+ * @brief Set up periodic release of the calling task
+ *
+ * The first release is the next multiple of period_ms of uptime.
+ */
+int bl_osal_periodic_init(bl_osal_periodic_t *periodic, uint32_t period_ms)
+{
+    if (!periodic || period_ms == 0U) {
+        return -EINVAL;
+    }
+
+    periodic->period_ms = period_ms;
+    periodic->release = ((uint64_t)k_uptime_get() / period_ms) + 1U;
+    periodic->cycles = 0;
+    periodic->overruns = 0;
+    periodic->skipped = 0;
+
+    return 0;
+}
+
+/**
+ * @brief Wait for the next release of a periodic task
+ *
+ * Sleeps until an absolute release time, so neither the execution time of
+ * the cycle nor the scheduling delay shifts later releases. A cycle that
+ * ends after its next release returns at once (overrun); releases that
+ * went by entirely are skipped to keep the phase.
+ * @return Number of releases skipped, negative errno on invalid arguments
+ */
+int bl_osal_periodic_wait(bl_osal_periodic_t *periodic)
+{
+    const char *name;
+    uint64_t due;
+    int64_t next;
+    int64_t now;
+    uint32_t skipped = 0;
+
+    if (!periodic || periodic->period_ms == 0U) {
+        return -EINVAL;
+    }
+
+    periodic->cycles++;
+    next = (int64_t)k_ms_to_ticks_near64(periodic->release * periodic->period_ms);
+    now = k_uptime_ticks();
+
+    if (now < next) {
+        periodic->release++;
+        k_sleep(K_TIMEOUT_ABS_TICKS(next));
+        return 0;
+    }
+
+    periodic->overruns++;
+
+    /* Run at once for the latest release that is due, drop the older ones */
+    due = MAX(k_ticks_to_ms_floor64(now) / periodic->period_ms, periodic->release);
+    skipped = (uint32_t)(due - periodic->release);
+    periodic->release = due + 1U;
+
+    if (skipped > 0U) {
+        periodic->skipped += skipped;
+        name = k_thread_name_get(k_current_get());
+        LOG_WRN("Task %s skipped %u cycles", name ? name : "?", skipped);
+    }
+
+    return (int)skipped;
+}
+
 /**
  * @brief Get system tick in milliseconds
  */
@@ -183,6 +724,119 @@ uint32_t bl_osal_get_tick_ms(void)
     return k_uptime_get_32();
 }
 
+/**
+ * @brief Cycle counter of this core, extended to 64 bits
+ *
+ * Without a 64-bit hardware counter the 32-bit one is extended on every
+ * read; bl_time_wrap_timer makes sure no wrap goes unseen.
+ */
+static uint64_t bl_time_cycles(void)
+{
+    k_spinlock_key_t key;
+    uint32_t now;
+    uint64_t cycles;
+
+    if (IS_ENABLED(CONFIG_TIMER_HAS_64BIT_CYCLE_COUNTER)) {
+        return k_cycle_get_64();
+    }
+
+    key = k_spin_lock(&bl_time_lock);
+    now = k_cycle_get_32();
+    if (now < bl_time_last_cycles) {
+        bl_time_high_cycles += BIT64(32);
+    }
+    bl_time_last_cycles = now;
+    cycles = bl_time_high_cycles | now;
+    k_spin_unlock(&bl_time_lock, key);
+
+    return cycles;
+}
+
+static void bl_time_wrap_handler(struct k_timer *timer)
+{
+    ARG_UNUSED(timer);
+
+    (void)bl_time_cycles();
+}
+
+/**
+ * @brief Time since boot of this core's clock, in microseconds
+ */
+uint64_t bl_osal_get_local_time_us(void)
+{
+    return k_cyc_to_us_floor64(bl_time_cycles());
+}
+
+#if defined(CORE_CM4) && !defined(BL_IPC_LOOPBACK)
+/**
+ * @brief Offset of the M7 clock at a local time (time sync lock held)
+ *
+ * A correction is slewed in at BL_TIME_SYNC_SLEW_PPM rather than stepped,
+ * so consecutive readings keep their order.
+ */
+static int64_t bl_time_sync_offset_at(uint64_t local_us)
+{
+    int64_t elapsed = (int64_t)(local_us - bl_time_sync.base_us);
+    int64_t slew = 0;
+
+    if (elapsed > 0) {
+        slew = (elapsed * BL_TIME_SYNC_SLEW_PPM) / 1000000LL;
+        if (bl_time_sync.slew_us >= 0) {
+            slew = MIN(slew, bl_time_sync.slew_us);
+        } else {
+            slew = MAX(-slew, bl_time_sync.slew_us);
+        }
+    }
+
+    return bl_time_sync.offset_us + ((elapsed * bl_time_sync.drift_ppb) / 1000000000LL) + slew;
+}
+#endif
+
+/**
+ * @brief Convert a local time to the shared (M7) timebase
+ *
+ * On M7 both are the same clock. On M4 the estimate is applied; until the
+ * first exchange has completed, local time is returned unchanged.
+ */
+uint64_t bl_osal_local_to_shared_us(uint64_t local_us)
+{
+#if defined(CORE_CM4) && !defined(BL_IPC_LOOPBACK)
+    k_spinlock_key_t key = k_spin_lock(&bl_time_sync.lock);
+    int64_t shared = (int64_t)local_us + bl_time_sync_offset_at(local_us);
+
+    k_spin_unlock(&bl_time_sync.lock, key);
+    return (uint64_t)shared;
+#else
+    return local_us;
+#endif
+}
+
+/**
+ * @brief Time on the shared (M7) timebase, in microseconds
+ *
+ * Timestamps taken with this on either core can be compared directly. On M4
+ * the result never goes back, even when the first estimate steps the clock.
+ */
+uint64_t bl_osal_get_time_us(void)
+{
+#if defined(CORE_CM4) && !defined(BL_IPC_LOOPBACK)
+    k_spinlock_key_t key = k_spin_lock(&bl_time_sync.lock);
+    uint64_t local_us = bl_osal_get_local_time_us();
+    uint64_t shared = (uint64_t)((int64_t)local_us + bl_time_sync_offset_at(local_us));
+
+    if (shared < bl_time_sync.last_shared_us) {
+        shared = bl_time_sync.last_shared_us;
+    } else {
+        bl_time_sync.last_shared_us = shared;
+    }
+
+    k_spin_unlock(&bl_time_sync.lock, key);
+    return shared;
+#else
+    return bl_osal_local_to_shared_us(bl_osal_get_local_time_us());
+#endif
+}
+
 /**
  * @brief Initialize IPC
  */
@@ -194,21 +848,67 @@ int bl_osal_ipc_init(void)
     LOG_INF("Initializing IPC");
 
     /* Get IPC device */
-    ipc_dev = DEVICE_DT_GET(DT_NODELABEL(mu1));
+    ipc_dev = DEVICE_DT_GET(BL_IPC_INSTANCE_NODE);
     if (!device_is_ready(ipc_dev)) {
         LOG_ERR("IPC device not ready");
         return -ENODEV;
     }
 
-    /* Register IPC endpoint */
-    ret = ipc_service_register_endpoint(ipc_dev, &bl_ipc_ept, &bl_ipc_ept_cfg);
+    ret = ipc_service_open_instance(ipc_dev);
+    if (ret < 0 && ret != -EALREADY) {
+        LOG_ERR("Failed to open IPC instance: %d", ret);
+        return ret;
+    }
+
+    /* On native_sim the shared data region is only mapped by now */
+    bl_ipc_shm_base = BL_SHARED_DATA_ADDR;
+    bl_ipc_flow_shm = (bl_ipc_flow_shm_t *)(bl_ipc_shm_base + BL_SHM_IPC_FLOW_OFFSET);
+
+    /* Set up the per-lane transmit batches */
+    for (uint32_t lane = 0; lane < BL_IPC_LANE_MAX; lane++) {
+        k_mutex_init(&bl_ipc_batch[lane].lock);
+        k_work_init_delayable(&bl_ipc_batch[lane].flush_work, bl_ipc_batch_flush_work);
+        bl_ipc_batch[lane].lane = lane;
+    }
+
+    /* Flow control state must be reset before the peer attaches to the streams */
+    bl_osal_ipc_flow_init();
+
+    ret = bl_osal_ipc_mailbox_init();
+    if (ret < 0) {
+        LOG_ERR("Failed to initialize IPC mailboxes: %d", ret);
+        return ret;
+    }
+
+    /* Set up the shared-memory streams before the peer can bind */
+    ret = bl_osal_ipc_stream_init();
     if (ret < 0) {
-        LOG_ERR("Failed to register IPC endpoint: %d", ret);
+        LOG_ERR("Failed to initialize IPC streams: %d", ret);
         return ret;
     }
 
-    /* Wait for endpoint to be bound */
-    k_sem_take(&bl_ipc_bound_sem, K_FOREVER);
+    /* Register one IPC endpoint per lane */
+    for (uint32_t lane = 0; lane < BL_IPC_LANE_MAX; lane++) {
+        ret = ipc_service_register_endpoint(ipc_dev, &bl_ipc_ept[lane],
+                                            &bl_ipc_ept_cfg[lane]);
+        if (ret < 0) {
+            LOG_ERR("Failed to register IPC endpoint %s: %d",
+                    bl_ipc_ept_cfg[lane].name, ret);
+            return ret;
+        }
+    }
+
+    /* Wait for all endpoints to be bound */
+    for (uint32_t lane = 0; lane < BL_IPC_LANE_MAX; lane++) {
+        k_sem_take(&bl_ipc_bound_sem, K_FOREVER);
+    }
+
+#ifdef CORE_CM4
+    /* Follow the M7 clock from now on */
+    k_work_schedule(&bl_time_sync_work, K_NO_WAIT);
+#endif
+
+    bl_rpc_init();
 
     LOG_INF("IPC initialized successfully");
     return 0;
@@ -217,60 +917,1334 @@ int bl_osal_ipc_init(void)
 /**
  * @brief Send IPC message
  */
-int bl_osal_ipc_send(void *data, size_t len)
+int bl_osal_ipc_send(uint32_t lane, void *data, size_t len)
 {
-    if (!data || len == 0 || len > BL_IPC_MSG_MAX_SIZE) {
+    if (lane >= BL_IPC_LANE_MAX || !data || len == 0 || len > sizeof(bl_ipc_msg_t)) {
         return -EINVAL;
     }
 
-    return ipc_service_send(&bl_ipc_ept, data, len);
+    return ipc_service_send(&bl_ipc_ept[lane], data, len);
 }
 
 /**
- * @brief Receive IPC message
+ * @brief Receive the next message descriptor of an IPC lane
  */
-int bl_osal_ipc_recv(void *data, size_t len, k_timeout_t timeout)
+int bl_osal_ipc_recv(uint32_t lane, void *data, size_t len, k_timeout_t timeout)
 {
-    bl_ipc_msg_t msg;
     int ret;
 
-    if (!data || len == 0) {
+    if (lane >= BL_IPC_LANE_MAX || !data || len != sizeof(bl_ipc_rx_desc_t)) {
         return -EINVAL;
     }
 
-    ret = k_msgq_get(&bl_ipc_rx_msgq, &msg, timeout);
-    if (ret == 0) {
-        size_t copy_len = MIN(len, sizeof(msg));
-        memcpy(data, &msg, copy_len);
-        return copy_len;
+    ret = k_msgq_get(bl_ipc_rx_msgq[lane], data, timeout);
+    if (ret < 0) {
+        return ret;
     }
 
-    return ret;
+    /* The queue slot is free again: return its credit to the sender */
+    bl_ipc_credit_return(lane, 1U);
+    return (int)len;
 }
 
 /**
- * @brief Send inter-core message
+ * @brief Get the RX queue of an IPC lane
  */
-int bl_ipc_send_msg(bl_ipc_msg_t *msg)
+struct k_msgq* bl_osal_ipc_get_rx_queue(uint32_t lane)
 {
-    if (!msg) {
+    if (lane >= BL_IPC_LANE_MAX) {
+        return NULL;
+    }
+
+    return bl_ipc_rx_msgq[lane];
+}
+
+/**
+ * @brief Keep a received vring buffer after the receive callback returns
+ */
+int bl_osal_ipc_hold_rx_buffer(uint32_t lane, const void *data)
+{
+    if (lane >= BL_IPC_LANE_MAX || !data) {
         return -EINVAL;
     }
 
-    msg->timestamp = bl_osal_get_tick_ms();
-    return bl_osal_ipc_send(msg, sizeof(bl_ipc_msg_t));
+    return ipc_service_hold_rx_buffer(&bl_ipc_ept[lane], (void *)data);
 }
 
 /**
- * @brief Receive inter-core message
+ * @brief Give a held vring buffer back to the peer
  */
-int bl_ipc_recv_msg(bl_ipc_msg_t *msg, k_timeout_t timeout)
+int bl_osal_ipc_release_rx_buffer(uint32_t lane, const void *data)
 {
-    if (!msg) {
+    if (lane >= BL_IPC_LANE_MAX || !data) {
+        return -EINVAL;
+    }
+
+    return ipc_service_release_rx_buffer(&bl_ipc_ept[lane], (void *)data);
+}
+
+/**
+ * @brief Borrow a TX buffer from the shared-memory vring
+ */
+int bl_osal_ipc_get_tx_buffer(uint32_t lane, void **data, uint32_t *size, k_timeout_t timeout)
+{
+    if (lane >= BL_IPC_LANE_MAX || !data || !size || *size == 0) {
+        return -EINVAL;
+    }
+
+    return ipc_service_get_tx_buffer(&bl_ipc_ept[lane], data, size, timeout);
+}
+
+/**
+ * @brief Send a previously borrowed TX buffer without copying
+ */
+int bl_osal_ipc_send_nocopy(uint32_t lane, const void *data, size_t len)
+{
+    if (lane >= BL_IPC_LANE_MAX || !data || len == 0) {
+        return -EINVAL;
+    }
+
+    return ipc_service_send_nocopy(&bl_ipc_ept[lane], data, len);
+}
+
+/**
+ * @brief Return a borrowed TX buffer to the vring without sending it
+ */
+int bl_osal_ipc_drop_tx_buffer(uint32_t lane, const void *data)
+{
+    if (lane >= BL_IPC_LANE_MAX || !data) {
         return -EINVAL;
     }
 
-    return bl_osal_ipc_recv(msg, sizeof(bl_ipc_msg_t), timeout);
+    return ipc_service_drop_tx_buffer(&bl_ipc_ept[lane], data);
+}
+
+#ifdef BL_IPC_STREAM_HAS_DOORBELL
+static void bl_ipc_stream_isr_handler(void *arg);
+
+/* Stream doorbell interrupt (M7): readers are woken in interrupt context */
+BL_OSAL_ISR_CAT1_DEFINE(bl_ipc_stream_isr, bl_ipc_stream_isr_handler, NULL);
+
+/**
+ * @brief Stream doorbell: signal the M7 through the MU
+ */
+static BL_HOT_CODE void bl_ipc_stream_doorbell(void *arg)
+{
+    ARG_UNUSED(arg);
+    mbox_send_dt(&bl_ipc_stream_mbox, NULL);
+}
+
+/**
+ * @brief Stream doorbell receive callback (MU interrupt context)
+ */
+static BL_HOT_CODE void bl_ipc_stream_mbox_cb(const struct device *dev, mbox_channel_id_t channel_id,
+                                              void *user_data, struct mbox_msg *data)
+{
+    bl_osal_isr_raise(&bl_ipc_stream_isr, bl_osal_prof_get_cycles());
+}
+
+/**
+ * @brief Stream doorbell handler: wake the stream readers
+ */
+static BL_HOT_CODE void bl_ipc_stream_isr_handler(void *arg)
+{
+    ARG_UNUSED(arg);
+
+    for (uint32_t id = 0; id < BL_IPC_STREAM_MAX; id++) {
+        bl_stream_notify(&bl_ipc_streams[id]);
+    }
+}
+#endif /* BL_IPC_STREAM_HAS_DOORBELL */
+
+/**
+ * @brief Reset the local flow control state (M7 also clears the shared block)
+ *
+ * M7 clears both cores' blocks before it creates the streams, and M4 only
+ * attaches once the streams exist, so M4 never sees a stale block.
+ */
+static void bl_osal_ipc_flow_init(void)
+{
+    memset(bl_ipc_credit_sent, 0, sizeof(bl_ipc_credit_sent));
+
+#ifdef CORE_CM7
+    memset(bl_ipc_flow_shm, 0, sizeof(*bl_ipc_flow_shm));
+    sys_cache_data_flush_range(bl_ipc_flow_shm, sizeof(*bl_ipc_flow_shm));
+#endif
+}
+
+/**
+ * @brief Take one credit of a lane for a message, waiting as its policy allows
+ *
+ * Credits come back through shared memory rather than an interrupt, so a
+ * blocked sender re-checks once per tick.
+ *
+ * @return 0 on success, -ENOBUFS if the peer had no free RX slot in time
+ */
+static int bl_ipc_credit_take(uint32_t msg_type, uint32_t lane, k_timeout_t timeout)
+{
+    volatile uint32_t *consumed = &bl_ipc_flow_shm->core[BL_IPC_CORE_PEER].consumed[lane];
+    k_timepoint_t end;
+    k_spinlock_key_t key;
+    bool waited = false;
+
+    if (bl_ipc_msg_policy[msg_type] == BL_IPC_FLOW_DROP) {
+        timeout = K_NO_WAIT;
+    }
+    end = sys_timepoint_calc(timeout);
+
+    while (1) {
+        sys_cache_data_invd_range((void *)consumed, sizeof(*consumed));
+
+        key = k_spin_lock(&bl_ipc_stats_lock);
+        if ((bl_ipc_credit_sent[lane] - *consumed) < bl_ipc_lane_depth[lane]) {
+            bl_ipc_credit_sent[lane]++;
+            k_spin_unlock(&bl_ipc_stats_lock, key);
+            return 0;
+        }
+        k_spin_unlock(&bl_ipc_stats_lock, key);
+
+        if (!waited) {
+            BL_IPC_TYPE_COUNT(msg_type, backpressure);
+            waited = true;
+        }
+
+        if (sys_timepoint_expired(end)) {
+            BL_IPC_TYPE_COUNT(msg_type, dropped);
+            return -ENOBUFS;
+        }
+
+        k_sleep(K_TICKS(1));
+    }
+}
+
+/**
+ * @brief Give back a credit taken for a message that was not sent
+ */
+static void bl_ipc_credit_refund(uint32_t lane)
+{
+    k_spinlock_key_t key = k_spin_lock(&bl_ipc_stats_lock);
+
+    bl_ipc_credit_sent[lane]--;
+
+    k_spin_unlock(&bl_ipc_stats_lock, key);
+}
+
+/**
+ * @brief Advertise freed RX slots of a lane to the peer
+ */
+static void bl_ipc_credit_return(uint32_t lane, uint32_t count)
+{
+    volatile uint32_t *consumed = &bl_ipc_flow_shm->core[BL_IPC_CORE_LOCAL].consumed[lane];
+    k_spinlock_key_t key = k_spin_lock(&bl_ipc_stats_lock);
+
+    *consumed += count;
+    sys_cache_data_flush_range((void *)consumed, sizeof(*consumed));
+
+    k_spin_unlock(&bl_ipc_stats_lock, key);
+}
+
+/**
+ * @brief Increment one per-type counter of the local core
+ *
+ * The counters live in shared memory so that the peer can read them too.
+ */
+static void bl_ipc_type_count(uint32_t msg_type, size_t counter)
+{
+    bl_ipc_type_stats_t *stats = &bl_ipc_flow_shm->core[BL_IPC_CORE_LOCAL].stats[msg_type];
+    k_spinlock_key_t key = k_spin_lock(&bl_ipc_stats_lock);
+
+    (*(uint32_t *)((uint8_t *)stats + counter))++;
+    sys_cache_data_flush_range(stats, sizeof(*stats));
+
+    k_spin_unlock(&bl_ipc_stats_lock, key);
+}
+
+/**
+ * @brief Get the per-type message counters of either core
+ */
+int bl_ipc_get_type_stats(bl_ipc_core_t core, bl_msg_type_t msg_type, bl_ipc_type_stats_t *stats)
+{
+    bl_ipc_type_stats_t *src;
+    k_spinlock_key_t key;
+
+    if (core >= BL_IPC_CORE_MAX || msg_type >= BL_MSG_TYPE_MAX || !stats) {
+        return -EINVAL;
+    }
+
+    if (!bl_ipc_flow_shm) {
+        return -ENODEV;
+    }
+
+    src = &bl_ipc_flow_shm->core[core].stats[msg_type];
+
+    key = k_spin_lock(&bl_ipc_stats_lock);
+    if (core != BL_IPC_CORE_LOCAL) {
+        sys_cache_data_invd_range(src, sizeof(*src));
+    }
+    *stats = *src;
+    k_spin_unlock(&bl_ipc_stats_lock, key);
+
+    return 0;
+}
+
+/**
+ * @brief Log the per-type counters of both cores for types that lost messages
+ *
+ * Intended to be called once per second (1000ms task).
+ */
+void bl_ipc_log_flow_stats(void)
+{
+    static bl_ipc_type_stats_t last[BL_IPC_CORE_MAX][BL_MSG_TYPE_MAX];
+    static const char *const core_name[BL_IPC_CORE_MAX] = { "M7", "M4" };
+    bl_ipc_type_stats_t now;
+
+    for (uint32_t core = 0; core < BL_IPC_CORE_MAX; core++) {
+        for (uint32_t type = 0; type < BL_MSG_TYPE_MAX; type++) {
+            bl_ipc_get_type_stats(core, type, &now);
+
+            if (now.dropped != last[core][type].dropped ||
+                now.backpressure != last[core][type].backpressure) {
+                LOG_WRN("IPC %s type %u: sent %u, received %u, dropped %u, backpressure %u",
+                        core_name[core], type, now.sent, now.received,
+                        now.dropped, now.backpressure);
+            }
+
+            last[core][type] = now;
+        }
+    }
+}
+
+/**
+ * @brief Initialize the shared-memory sample streams
+ *
+ * The M7 consumes and creates the rings, the M4 produces and attaches. The
+ * M7 creates them before registering its endpoints, so by the time the M4
+ * sees its endpoints bound the rings are valid.
+ */
+static int bl_osal_ipc_stream_init(void)
+{
+    void *shm;
+    int ret;
+
+    for (uint32_t id = 0; id < BL_IPC_STREAM_MAX; id++) {
+        shm = (void *)(bl_ipc_shm_base + bl_ipc_stream_cfg[id].shm_offset);
+#ifdef CORE_CM7
+        ret = bl_stream_init(&bl_ipc_streams[id], shm,
+                             bl_ipc_stream_cfg[id].shm_size, bl_ipc_stream_cfg[id].elem_size,
+                             true);
+#else
+        do {
+            ret = bl_stream_init(&bl_ipc_streams[id], shm,
+                                 bl_ipc_stream_cfg[id].shm_size, bl_ipc_stream_cfg[id].elem_size,
+                                 false);
+        } while (ret == -EAGAIN && k_msleep(1) == 0);
+#endif
+        if (ret < 0) {
+            return ret;
+        }
+
+#if defined(BL_IPC_STREAM_HAS_DOORBELL) && defined(CORE_CM4)
+        bl_stream_set_doorbell(&bl_ipc_streams[id], bl_ipc_stream_doorbell, NULL,
+                               BL_STREAM_DOORBELL_BATCH);
+#endif
+    }
+
+#if defined(BL_IPC_STREAM_HAS_DOORBELL) && defined(CORE_CM7)
+    ret = bl_osal_isr_init(&bl_ipc_stream_isr);
+    if (ret < 0) {
+        return ret;
+    }
+
+    ret = mbox_register_callback_dt(&bl_ipc_stream_mbox, bl_ipc_stream_mbox_cb, NULL);
+    if (ret < 0) {
+        return ret;
+    }
+
+    ret = mbox_set_enabled_dt(&bl_ipc_stream_mbox, true);
+    if (ret < 0) {
+        return ret;
+    }
+#endif
+
+    return 0;
+}
+
+/**
+ * @brief Create (M7) or attach to (M4) the shared-memory mailboxes
+ */
+static int bl_osal_ipc_mailbox_init(void)
+{
+    void *shm;
+    int ret;
+
+    for (uint32_t id = 0; id < BL_IPC_MAILBOX_MAX; id++) {
+        shm = (void *)(bl_ipc_shm_base + bl_ipc_mailbox_cfg[id].shm_offset);
+#ifdef CORE_CM7
+        ret = bl_mailbox_init(&bl_ipc_mailboxes[id], shm,
+                              bl_ipc_mailbox_cfg[id].shm_size, bl_ipc_mailbox_cfg[id].size,
+                              true);
+#else
+        do {
+            ret = bl_mailbox_init(&bl_ipc_mailboxes[id], shm,
+                                  bl_ipc_mailbox_cfg[id].shm_size, bl_ipc_mailbox_cfg[id].size,
+                                  false);
+        } while (ret == -EAGAIN && k_msleep(1) == 0);
+#endif
+        if (ret < 0) {
+            return ret;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Publish a new value to a mailbox (M4)
+ *
+ * Publishers of the same mailbox must be serialised by the caller.
+ */
+int bl_ipc_mailbox_publish(bl_ipc_mailbox_id_t id, const void *data)
+{
+    if (id >= BL_IPC_MAILBOX_MAX || !data) {
+        return -EINVAL;
+    }
+
+    bl_mailbox_publish(&bl_ipc_mailboxes[id], data);
+    return 0;
+}
+
+/**
+ * @brief Copy the latest value of a mailbox (M7)
+ * @return 0 on success, -ENODATA if nothing was published yet, negative on error
+ */
+int bl_ipc_mailbox_read(bl_ipc_mailbox_id_t id, void *data, uint32_t *seq)
+{
+    if (id >= BL_IPC_MAILBOX_MAX || !data) {
+        return -EINVAL;
+    }
+
+    return bl_mailbox_read(&bl_ipc_mailboxes[id], data, seq);
+}
+
+/**
+ * @brief Write samples to an inter-core stream (M4)
+ * @return Number of samples written, negative on error
+ */
+int bl_ipc_stream_write(bl_ipc_stream_id_t id, const void *samples, uint32_t count)
+{
+    if (id >= BL_IPC_STREAM_MAX || !samples) {
+        return -EINVAL;
+    }
+
+    return (int)bl_stream_write(&bl_ipc_streams[id], samples, count);
+}
+
+/**
+ * @brief Ring the doorbell for samples not yet announced (M4)
+ */
+void bl_ipc_stream_flush(bl_ipc_stream_id_t id)
+{
+    if (id < BL_IPC_STREAM_MAX) {
+        bl_stream_flush(&bl_ipc_streams[id]);
+    }
+}
+
+/**
+ * @brief Read samples from an inter-core stream (M7)
+ * @return Number of samples read, negative on error or timeout
+ */
+int bl_ipc_stream_read(bl_ipc_stream_id_t id, void *samples, uint32_t max, k_timeout_t timeout)
+{
+    int ret;
+
+    if (id >= BL_IPC_STREAM_MAX || !samples) {
+        return -EINVAL;
+    }
+
+    ret = bl_stream_wait(&bl_ipc_streams[id], timeout);
+    if (ret < 0) {
+        return ret;
+    }
+
+    return (int)bl_stream_read(&bl_ipc_streams[id], samples, max);
+}
+
+/**
+ * @brief Get the lane a message type is carried on
+ */
+bl_ipc_lane_t bl_ipc_get_lane(uint32_t msg_type)
+{
+    if (msg_type >= BL_MSG_TYPE_MAX) {
+        return BL_IPC_LANE_BULK;
+    }
+
+    return (bl_ipc_lane_t)bl_ipc_msg_lane[msg_type];
+}
+
+/**
+ * @brief Account one transmit operation in the IPC statistics
+ */
+static void bl_ipc_account_tx(bl_ipc_tx_path_stats_t *path, uint32_t msgs,
+                              uint32_t copied, uint32_t sent, uint32_t cycles)
+{
+    k_spinlock_key_t key = k_spin_lock(&bl_ipc_stats_lock);
+
+    path->msg_count += msgs;
+    path->bytes_copied += copied;
+    path->bytes_sent += sent;
+    path->cycles += cycles;
+
+    k_spin_unlock(&bl_ipc_stats_lock, key);
+}
+
+/**
+ * @brief Account one vring buffer handed to the peer
+ */
+static void bl_ipc_account_buffer(void)
+{
+    k_spinlock_key_t key = k_spin_lock(&bl_ipc_stats_lock);
+
+    bl_ipc_tx_stats.buffers_sent++;
+
+    k_spin_unlock(&bl_ipc_stats_lock, key);
+}
+
+/**
+ * @brief Account the records of a batch that could not be sent as dropped
+ */
+static void bl_ipc_batch_discard(bl_ipc_batch_t *batch)
+{
+    const bl_ipc_msg_t *rec;
+    uint32_t offset = 0;
+
+    while (offset < batch->used) {
+        rec = (const bl_ipc_msg_t *)&batch->buf[offset];
+        BL_IPC_TYPE_COUNT(rec->msg_type, dropped);
+        bl_ipc_credit_refund(batch->lane);
+        offset += ROUND_UP(BL_IPC_MSG_WIRE_SIZE(rec), BL_IPC_RECORD_ALIGN);
+    }
+}
+
+/**
+ * @brief Send the records collected in a batch (caller holds batch->lock)
+ */
+static int bl_ipc_batch_flush_locked(bl_ipc_batch_t *batch)
+{
+    int ret = 0;
+
+    if (!batch->buf) {
+        return 0;
+    }
+
+    if (batch->used == 0) {
+        bl_osal_ipc_drop_tx_buffer(batch->lane, batch->buf);
+    } else {
+        ret = bl_osal_ipc_send_nocopy(batch->lane, batch->buf, batch->used);
+        if (ret < 0) {
+            LOG_ERR("Failed to send IPC batch on lane %u: %d", batch->lane, ret);
+            bl_ipc_batch_discard(batch);
+            bl_osal_ipc_drop_tx_buffer(batch->lane, batch->buf);
+        } else {
+            bl_ipc_account_buffer();
+            ret = 0;
+        }
+    }
+
+    batch->buf = NULL;
+    batch->used = 0;
+    return ret;
+}
+
+/**
+ * @brief Make room for a record of len bytes (caller holds batch->lock)
+ *
+ * A batch without a buffer takes *spare (size bytes) and clears it; the
+ * caller waits for a spare buffer with the lock released.
+ * @return Pointer to the 8-byte aligned record slot, NULL if none available
+ */
+static uint8_t* bl_ipc_batch_reserve(bl_ipc_batch_t *batch, uint32_t len,
+                                     void **spare, uint32_t size)
+{
+    uint32_t offset;
+
+    offset = ROUND_UP(batch->used, BL_IPC_RECORD_ALIGN);
+    if (batch->buf && (offset + len) > batch->size) {
+        bl_ipc_batch_flush_locked(batch);
+        offset = 0;
+    }
+
+    if (!batch->buf) {
+        if (!*spare) {
+            return NULL;
+        }
+
+        batch->buf = *spare;
+        batch->size = size;
+        batch->used = 0;
+        *spare = NULL;
+        offset = 0;
+    }
+
+    if ((offset + len) > batch->size) {
+        return NULL;
+    }
+
+    return &batch->buf[offset];
+}
+
+/**
+ * @brief Close a record written at rec (caller holds batch->lock)
+ *
+ * The first record of a batch arms the deadline, a batch that cannot take
+ * another header is sent right away.
+ */
+static void bl_ipc_batch_append(bl_ipc_batch_t *batch, const uint8_t *rec, uint32_t len)
+{
+    bool first = (batch->used == 0);
+
+    batch->used = (uint32_t)(rec - batch->buf) + len;
+
+    if ((ROUND_UP(batch->used, BL_IPC_RECORD_ALIGN) + BL_IPC_MSG_HDR_SIZE) > batch->size) {
+        bl_ipc_batch_flush_locked(batch);
+    } else if (first) {
+        k_work_reschedule(&batch->flush_work, K_USEC(BL_IPC_COALESCE_DEADLINE_US));
+    }
+}
+
+/**
+ * @brief Deadline expiry: send whatever the batch holds
+ */
+static void bl_ipc_batch_flush_work(struct k_work *work)
+{
+    struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+    bl_ipc_batch_t *batch = CONTAINER_OF(dwork, bl_ipc_batch_t, flush_work);
+
+    k_mutex_lock(&batch->lock, K_FOREVER);
+    bl_ipc_batch_flush_locked(batch);
+    k_mutex_unlock(&batch->lock);
+}
+
+/**
+ * @brief Send all pending coalesced records without waiting for the deadline
+ */
+void bl_ipc_flush(void)
+{
+    for (uint32_t lane = 0; lane < BL_IPC_LANE_MAX; lane++) {
+        if (bl_ipc_lane_coalesce[lane]) {
+            k_mutex_lock(&bl_ipc_batch[lane].lock, K_FOREVER);
+            bl_ipc_batch_flush_locked(&bl_ipc_batch[lane]);
+            k_mutex_unlock(&bl_ipc_batch[lane].lock);
+        }
+    }
+}
+
+/**
+ * @brief Send inter-core message
+ *
+ * On coalescing lanes the message is appended to the current batch and goes
+ * out when the batch is full or its deadline expires; other lanes send it
+ * immediately.
+ */
+int bl_ipc_send_msg(bl_ipc_msg_t *msg)
+{
+    return bl_ipc_send_msg_id(msg, 0U);
+}
+
+/**
+ * @brief Send a message carrying an RPC correlation ID
+ */
+int bl_ipc_send_msg_id(bl_ipc_msg_t *msg, uint32_t rpc_id)
+{
+    bl_ipc_lane_t lane;
+    bl_ipc_batch_t *batch;
+    uint8_t *rec;
+    void *spare = NULL;
+    uint32_t size = 0;
+    uint32_t start;
+    int len;
+    int ret;
+
+    if (!msg) {
+        return -EINVAL;
+    }
+
+    start = k_cycle_get_32();
+    msg->rpc_id = rpc_id;
+    msg->timestamp = bl_osal_get_time_us();
+
+    len = bl_ipc_encode(msg);
+    if (len < 0) {
+        return len;
+    }
+
+    lane = bl_ipc_get_lane(msg->msg_type);
+
+    ret = bl_ipc_credit_take(msg->msg_type, lane, K_MSEC(BL_IPC_CREDIT_TIMEOUT_MS));
+    if (ret < 0) {
+        return ret;
+    }
+
+    if (!bl_ipc_lane_coalesce[lane]) {
+        ret = bl_osal_ipc_send(lane, msg, len);
+        if (ret < 0) {
+            BL_IPC_TYPE_COUNT(msg->msg_type, dropped);
+            bl_ipc_credit_refund(lane);
+            return ret;
+        }
+        bl_ipc_account_buffer();
+    } else {
+        batch = &bl_ipc_batch[lane];
+
+        k_mutex_lock(&batch->lock, K_FOREVER);
+        rec = bl_ipc_batch_reserve(batch, len, &spare, size);
+        if (!rec && !batch->buf) {
+            /* Wait for a vring buffer without keeping other senders out */
+            k_mutex_unlock(&batch->lock);
+            size = BL_IPC_COALESCE_BUF_SIZE;
+            ret = bl_osal_ipc_get_tx_buffer(lane, &spare, &size, K_FOREVER);
+            k_mutex_lock(&batch->lock, K_FOREVER);
+            if (ret == 0) {
+                rec = bl_ipc_batch_reserve(batch, len, &spare, size);
+            }
+        }
+        if (rec) {
+            memcpy(rec, msg, len);
+            bl_ipc_batch_append(batch, rec, len);
+        }
+        k_mutex_unlock(&batch->lock);
+
+        /* Another sender supplied the batch buffer in the meantime */
+        if (spare) {
+            bl_osal_ipc_drop_tx_buffer(lane, spare);
+        }
+
+        if (!rec) {
+            BL_IPC_TYPE_COUNT(msg->msg_type, dropped);
+            bl_ipc_credit_refund(lane);
+            return -ENOMEM;
+        }
+    }
+
+    BL_IPC_TYPE_COUNT(msg->msg_type, sent);
+
+    bl_ipc_account_tx(&bl_ipc_tx_stats.copy, 1U, len, len,
+                      k_cycle_get_32() - start);
+    return 0;
+}
+
+/**
+ * @brief Borrow an inter-core message directly in shared memory
+ *
+ * The returned message lives in the vring TX buffer of the lane serving
+ * msg_type. The caller fills in data_len and data (msg_type must not be
+ * changed) and must hand it back with either bl_ipc_commit_tx() or
+ * bl_ipc_abort_tx(). On coalescing lanes the message is the first record of
+ * a batch buffer of its own; no lock is held until it is handed back.
+ */
+bl_ipc_msg_t* bl_ipc_alloc_tx(bl_msg_type_t msg_type, k_timeout_t timeout)
+{
+    bl_ipc_lane_t lane = bl_ipc_get_lane(msg_type);
+    k_timepoint_t deadline = sys_timepoint_calc(timeout);
+    bl_ipc_msg_t *msg;
+    void *buf = NULL;
+    uint32_t need;
+    uint32_t size;
+    uint32_t start;
+    int ret;
+
+    if (msg_type >= BL_MSG_TYPE_MAX) {
+        return NULL;
+    }
+
+    start = k_cycle_get_32();
+
+    /* Reserve the peer's RX slot first, the buffer is of no use without it.
+     * Both waits share the caller's timeout.
+     */
+    if (bl_ipc_credit_take(msg_type, lane, sys_timepoint_timeout(deadline)) < 0) {
+        return NULL;
+    }
+
+    /* On coalescing lanes the buffer becomes the batch buffer on commit */
+    need = bl_ipc_lane_coalesce[lane] ? BL_IPC_COALESCE_BUF_SIZE : sizeof(bl_ipc_msg_t);
+    size = need;
+
+    ret = bl_osal_ipc_get_tx_buffer(lane, &buf, &size, sys_timepoint_timeout(deadline));
+    if (ret < 0) {
+        LOG_DBG("No IPC TX buffer available: %d", ret);
+        goto no_buffer;
+    }
+
+    if (size < need) {
+        LOG_ERR("IPC TX buffer too small: %u bytes", size);
+        bl_osal_ipc_drop_tx_buffer(lane, buf);
+        goto no_buffer;
+    }
+
+    msg = (bl_ipc_msg_t *)buf;
+
+    msg->msg_type = msg_type;
+    msg->data_len = 0;
+    msg->rpc_id = 0;
+
+    bl_ipc_account_tx(&bl_ipc_tx_stats.nocopy, 0U, 0U, 0U, k_cycle_get_32() - start);
+    return msg;
+
+no_buffer:
+    BL_IPC_TYPE_COUNT(msg_type, dropped);
+    bl_ipc_credit_refund(lane);
+    return NULL;
+}
+
+/**
+ * @brief Send a message obtained from bl_ipc_alloc_tx()
+ *
+ * On coalescing lanes the records already batched are sent first, to keep
+ * the lane in order; the message's buffer then collects the next records.
+ */
+int bl_ipc_commit_tx(bl_ipc_msg_t *msg)
+{
+    bl_ipc_lane_t lane;
+    bl_ipc_batch_t *batch;
+    uint32_t start;
+    int len;
+    int ret;
+
+    if (!msg) {
+        return -EINVAL;
+    }
+
+    lane = bl_ipc_get_lane(msg->msg_type);
+    batch = &bl_ipc_batch[lane];
+
+    len = bl_ipc_encode(msg);
+    if (len < 0) {
+        bl_ipc_abort_tx(msg);
+        return len;
+    }
+
+    start = k_cycle_get_32();
+    msg->timestamp = bl_osal_get_time_us();
+
+    if (bl_ipc_lane_coalesce[lane]) {
+        k_mutex_lock(&batch->lock, K_FOREVER);
+        bl_ipc_batch_flush_locked(batch);
+        batch->buf = (uint8_t *)msg;
+        batch->size = BL_IPC_COALESCE_BUF_SIZE;
+        batch->used = 0;
+        bl_ipc_batch_append(batch, (uint8_t *)msg, len);
+        k_mutex_unlock(&batch->lock);
+    } else {
+        ret = bl_osal_ipc_send_nocopy(lane, msg, len);
+        if (ret < 0) {
+            BL_IPC_TYPE_COUNT(msg->msg_type, dropped);
+            bl_osal_ipc_drop_tx_buffer(lane, msg);
+            bl_ipc_credit_refund(lane);
+            return ret;
+        }
+        bl_ipc_account_buffer();
+    }
+
+    BL_IPC_TYPE_COUNT(msg->msg_type, sent);
+    bl_ipc_account_tx(&bl_ipc_tx_stats.nocopy, 1U, 0U, len, k_cycle_get_32() - start);
+    return 0;
+}
+
+/**
+ * @brief Release a message obtained from bl_ipc_alloc_tx() without sending
+ */
+void bl_ipc_abort_tx(bl_ipc_msg_t *msg)
+{
+    bl_ipc_lane_t lane;
+
+    if (!msg) {
+        return;
+    }
+
+    lane = bl_ipc_get_lane(msg->msg_type);
+
+    bl_osal_ipc_drop_tx_buffer(lane, msg);
+    bl_ipc_credit_refund(lane);
+}
+
+/**
+ * @brief Get a snapshot of the IPC transmit statistics
+ */
+void bl_ipc_get_tx_stats(bl_ipc_tx_stats_t *stats)
+{
+    k_spinlock_key_t key;
+
+    if (!stats) {
+        return;
+    }
+
+    key = k_spin_lock(&bl_ipc_stats_lock);
+    *stats = bl_ipc_tx_stats;
+    k_spin_unlock(&bl_ipc_stats_lock, key);
+}
+
+/**
+ * @brief Log per-second copy and cycle figures of both transmit paths
+ *
+ * Intended to be called once per second (1000ms task).
+ */
+void bl_ipc_log_tx_stats(void)
+{
+    static bl_ipc_tx_stats_t last;
+    bl_ipc_tx_stats_t now;
+    uint32_t copy_msgs, nocopy_msgs;
+
+    bl_ipc_get_tx_stats(&now);
+
+    copy_msgs = now.copy.msg_count - last.copy.msg_count;
+    nocopy_msgs = now.nocopy.msg_count - last.nocopy.msg_count;
+
+    LOG_INF("IPC TX buffers: %u buf/s", now.buffers_sent - last.buffers_sent);
+    LOG_INF("IPC TX copy: %u msg/s, %u B/s copied, %u B/s sent, %u cyc/msg",
+            copy_msgs,
+            now.copy.bytes_copied - last.copy.bytes_copied,
+            now.copy.bytes_sent - last.copy.bytes_sent,
+            copy_msgs ? (uint32_t)((now.copy.cycles - last.copy.cycles) / copy_msgs) : 0U);
+    LOG_INF("IPC TX nocopy: %u msg/s, %u B/s copied, %u B/s sent, %u cyc/msg",
+            nocopy_msgs,
+            now.nocopy.bytes_copied - last.nocopy.bytes_copied,
+            now.nocopy.bytes_sent - last.nocopy.bytes_sent,
+            nocopy_msgs ? (uint32_t)((now.nocopy.cycles - last.nocopy.cycles) / nocopy_msgs) : 0U);
+
+    last = now;
+}
+
+/**
+ * @brief Receive inter-core message without copying it
+ *
+ * desc->msg points into the shared-memory vring buffer and stays valid
+ * until bl_ipc_recv_release(); only the header and data_len bytes of data
+ * may be read. Hold messages briefly, the peer cannot reuse the buffer
+ * until every message in it has been released.
+ */
+int bl_ipc_recv_hold(bl_ipc_rx_desc_t *desc, k_timeout_t timeout)
+{
+    struct k_poll_event events[BL_IPC_LANE_MAX];
+    uint32_t lane;
+    int ret;
+
+    if (!desc) {
+        return -EINVAL;
+    }
+
+    /* Always serve the highest-priority lane with pending data first */
+    for (lane = 0; lane < BL_IPC_LANE_MAX; lane++) {
+        if (bl_osal_ipc_recv(lane, desc, sizeof(*desc), K_NO_WAIT) >= 0) {
+            return 0;
+        }
+    }
+
+    if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+        return -ENOMSG;
+    }
+
+    for (lane = 0; lane < BL_IPC_LANE_MAX; lane++) {
+        k_poll_event_init(&events[lane], K_POLL_TYPE_MSGQ_DATA_AVAILABLE,
+                          K_POLL_MODE_NOTIFY_ONLY, bl_ipc_rx_msgq[lane]);
+    }
+
+    ret = k_poll(events, BL_IPC_LANE_MAX, timeout);
+    if (ret < 0) {
+        return ret;
+    }
+
+    for (lane = 0; lane < BL_IPC_LANE_MAX; lane++) {
+        if (bl_osal_ipc_recv(lane, desc, sizeof(*desc), K_NO_WAIT) >= 0) {
+            return 0;
+        }
+    }
+
+    /* Another consumer took the message first */
+    return -EAGAIN;
+}
+
+/**
+ * @brief Release a message obtained from bl_ipc_recv_hold()
+ */
+void bl_ipc_recv_release(bl_ipc_rx_desc_t *desc)
+{
+    if (!desc || !desc->hold) {
+        return;
+    }
+
+    bl_ipc_rx_unref(desc->hold);
+    desc->msg = NULL;
+    desc->hold = NULL;
+}
+
+/**
+ * @brief Receive inter-core message
+ */
+int bl_ipc_recv_msg(bl_ipc_msg_t *msg, k_timeout_t timeout)
+{
+    bl_ipc_rx_desc_t desc;
+    int ret;
+
+    if (!msg) {
+        return -EINVAL;
+    }
+
+    ret = bl_ipc_recv_hold(&desc, timeout);
+    if (ret < 0) {
+        return ret;
+    }
+
+    memcpy(msg, desc.msg, BL_IPC_MSG_WIRE_SIZE(desc.msg));
+    bl_ipc_recv_release(&desc);
+    return 0;
+}
+
+/**
+ * @brief Keep a received message past its handler
+ *
+ * The message is copied out of its vring buffer, which the IPC layer
+ * releases, into a pool buffer of the size the message needs. The pool
+ * buffer belongs to the caller, who hands it on or drops it with
+ * bl_osal_buf_unref().
+ * @return Copy of the message, NULL if no buffer was free
+ */
+bl_ipc_msg_t *bl_ipc_msg_keep(const bl_ipc_msg_t *msg)
+{
+    bl_ipc_msg_t *copy;
+
+    if (!msg) {
+        return NULL;
+    }
+
+    copy = bl_osal_buf_alloc(BL_IPC_MSG_WIRE_SIZE(msg), K_NO_WAIT);
+    if (copy) {
+        memcpy(copy, msg, BL_IPC_MSG_WIRE_SIZE(msg));
+    }
+
+    return copy;
+}
+
+/**
+ * @brief Receive inter-core message from one lane only
+ */
+int bl_ipc_recv_lane_msg(bl_ipc_lane_t lane, bl_ipc_msg_t *msg, k_timeout_t timeout)
+{
+    bl_ipc_rx_desc_t desc;
+    int ret;
+
+    if (!msg) {
+        return -EINVAL;
+    }
+
+    ret = bl_osal_ipc_recv(lane, &desc, sizeof(desc), timeout);
+    if (ret < 0) {
+        return ret;
+    }
+
+    memcpy(msg, desc.msg, BL_IPC_MSG_WIRE_SIZE(desc.msg));
+    bl_ipc_recv_release(&desc);
+    return 0;
+}
+
+/**
+ * @brief Register the handler run by bl_ipc_dispatch() for a message type
+ *
+ * Passing a NULL handler removes the registration. Handlers are expected
+ * to be registered once at start-up, before dispatching begins.
+ */
+int bl_ipc_register_handler(bl_msg_type_t msg_type, bl_ipc_handler_t handler, void *ctx)
+{
+    k_spinlock_key_t key;
+
+    if (msg_type >= BL_MSG_TYPE_MAX) {
+        return -EINVAL;
+    }
+
+    key = k_spin_lock(&bl_ipc_stats_lock);
+    bl_ipc_handlers[msg_type].handler = handler;
+    bl_ipc_handlers[msg_type].ctx = ctx;
+    k_spin_unlock(&bl_ipc_stats_lock, key);
+
+    return 0;
+}
+
+/**
+ * @brief Wait for inter-core messages and run their handlers
+ *
+ * Blocks until a message arrives on any lane or the timeout expires, then
+ * dispatches every message already queued, highest-priority lane first.
+ * Handlers get the message in place in its vring buffer; it is released
+ * when the handler returns.
+ *
+ * @return Number of messages dispatched, or -EAGAIN on timeout
+ */
+int bl_ipc_dispatch(k_timeout_t timeout)
+{
+    bl_ipc_rx_desc_t desc;
+    bl_ipc_handler_t handler;
+    bl_ipc_handler_stats_t *stats;
+    k_spinlock_key_t key;
+    uint32_t start, cycles;
+    int count = 0;
+    int ret;
+
+    ret = bl_ipc_recv_hold(&desc, timeout);
+
+    while (ret == 0) {
+        /* The type was validated when the record was received */
+        handler = bl_ipc_handlers[desc.msg->msg_type].handler;
+        stats = &bl_ipc_handler_stats[desc.msg->msg_type];
+
+        if (!handler) {
+            LOG_WRN("No handler for message type: %d", desc.msg->msg_type);
+            key = k_spin_lock(&bl_ipc_stats_lock);
+            stats->unhandled++;
+            k_spin_unlock(&bl_ipc_stats_lock, key);
+        } else {
+            start = k_cycle_get_32();
+            handler(desc.msg, bl_ipc_handlers[desc.msg->msg_type].ctx);
+            cycles = k_cycle_get_32() - start;
+
+            key = k_spin_lock(&bl_ipc_stats_lock);
+            stats->count++;
+            stats->cycles += cycles;
+            stats->max_cycles = MAX(stats->max_cycles, cycles);
+            k_spin_unlock(&bl_ipc_stats_lock, key);
+        }
+
+        bl_ipc_recv_release(&desc);
+        count++;
+        ret = bl_ipc_recv_hold(&desc, K_NO_WAIT);
+    }
+
+    if (count > 0) {
+        return count;
+    }
+
+    return (ret == -ENOMSG) ? -EAGAIN : ret;
+}
+
+/**
+ * @brief Get a snapshot of the dispatch statistics of one message type
+ */
+void bl_ipc_get_handler_stats(bl_msg_type_t msg_type, bl_ipc_handler_stats_t *stats)
+{
+    k_spinlock_key_t key;
+
+    if (!stats || msg_type >= BL_MSG_TYPE_MAX) {
+        return;
+    }
+
+    key = k_spin_lock(&bl_ipc_stats_lock);
+    *stats = bl_ipc_handler_stats[msg_type];
+    k_spin_unlock(&bl_ipc_stats_lock, key);
+}
+
+/**
+ * @brief Log per-second handler counts and execution times of each message type
+ *
+ * Intended to be called once per second (1000ms task). Types without
+ * traffic in the last second are skipped.
+ */
+void bl_ipc_log_handler_stats(void)
+{
+    static bl_ipc_handler_stats_t last[BL_MSG_TYPE_MAX];
+    bl_ipc_handler_stats_t now;
+    uint32_t msgs;
+
+    for (uint32_t type = 0; type < BL_MSG_TYPE_MAX; type++) {
+        bl_ipc_get_handler_stats(type, &now);
+
+        msgs = now.count - last[type].count;
+        if (msgs > 0 || now.unhandled != last[type].unhandled) {
+            LOG_INF("IPC RX type %u: %u msg/s, %u unhandled/s, %u cyc/msg, %u cyc max",
+                    type, msgs, now.unhandled - last[type].unhandled,
+                    msgs ? (uint32_t)((now.cycles - last[type].cycles) / msgs) : 0U,
+                    now.max_cycles);
+        }
+
+        last[type] = now;
+    }
+}
+
+/**
+ * @brief Time sync exchange: M4 side sends a request
+ */
+#ifdef CORE_CM4
+static void bl_time_sync_work_handler(struct k_work *work)
+{
+    bl_msg_time_sync_t req = {0};
+    bl_ipc_msg_t msg;
+    k_spinlock_key_t key;
+
+    key = k_spin_lock(&bl_time_sync.lock);
+    req.seq = ++bl_time_sync.seq;
+    k_spin_unlock(&bl_time_sync.lock, key);
+
+    req.t1 = bl_osal_get_local_time_us();
+    bl_msg_time_sync_encode(&msg, &req);
+
+    /* A request lost for lack of credits only delays the next estimate */
+    (void)bl_ipc_send_msg(&msg);
+
+    k_work_schedule(k_work_delayable_from_work(work), K_MSEC(BL_TIME_SYNC_INTERVAL_MS));
+}
+#endif
+
+/**
+ * @brief Time sync exchange: M7 side sends the reply
+ *
+ * t3 is taken just before sending, so the time the reply waited for the
+ * workqueue is excluded from the round trip.
+ */
+#if defined(CORE_CM7) && !defined(BL_IPC_LOOPBACK)
+static void bl_time_sync_reply_handler(struct k_work *work)
+{
+    bl_msg_time_sync_t answer;
+    bl_ipc_msg_t reply;
+    k_spinlock_key_t key;
+
+    ARG_UNUSED(work);
+
+    key = k_spin_lock(&bl_time_sync.lock);
+    answer = bl_time_sync_reply;
+    k_spin_unlock(&bl_time_sync.lock, key);
+
+    answer.t3 = bl_osal_get_local_time_us();
+    bl_msg_time_sync_encode(&reply, &answer);
+
+    /* A reply lost for lack of credits only delays the next estimate */
+    (void)bl_ipc_send_msg(&reply);
+}
+#endif
+
+/**
+ * @brief Time sync exchange: M7 records requests, M4 evaluates replies
+ *
+ * Offset and round trip follow NTP:
+ *   offset = ((t2 - t1) + (t3 - t4)) / 2,  rtt = (t4 - t1) - (t3 - t2)
+ * Within a window only the sample with the shortest round trip is kept, as
+ * it is the one least disturbed by queuing. The drift is the slope between
+ * successive window estimates, smoothed over four windows. After the first
+ * window, the difference to the running offset is slewed in.
+ */
+static void bl_time_sync_rx(const bl_ipc_msg_t *msg, uint64_t rx_local_us)
+{
+    const bl_msg_time_sync_t *sync = bl_msg_time_sync_decode(msg);
+
+#if defined(CORE_CM7) && !defined(BL_IPC_LOOPBACK)
+    k_spinlock_key_t key;
+
+    if (sync->t2 != 0U) {
+        return;
+    }
+
+    /* M4 waits for each reply, so one pending request is enough; a newer
+     * one replaces it
+     */
+    key = k_spin_lock(&bl_time_sync.lock);
+    bl_time_sync_reply = *sync;
+    bl_time_sync_reply.t2 = rx_local_us;
+    k_spin_unlock(&bl_time_sync.lock, key);
+
+    k_work_submit(&bl_time_sync_reply_work);
+#elif defined(CORE_CM4) && !defined(BL_IPC_LOOPBACK)
+    k_spinlock_key_t key;
+    int64_t offset;
+    int64_t current;
+    int64_t slope;
+    uint32_t rtt;
+
+    if (sync->t2 == 0U) {
+        return;
+    }
+
+    offset = (((int64_t)(sync->t2 - sync->t1)) + ((int64_t)(sync->t3 - rx_local_us))) / 2;
+    rtt = (uint32_t)((rx_local_us - sync->t1) - (sync->t3 - sync->t2));
+
+    key = k_spin_lock(&bl_time_sync.lock);
+
+    /* Replies to older requests arrived too late to be useful */
+    if (sync->seq == bl_time_sync.seq) {
+        bl_time_sync.stats.exchanges++;
+
+        if (bl_time_sync.window == 0U || rtt < bl_time_sync.best_rtt_us) {
+            bl_time_sync.best_rtt_us = rtt;
+            bl_time_sync.best_offset_us = offset;
+            bl_time_sync.best_local_us = sync->t1 + ((rx_local_us - sync->t1) / 2U);
+        }
+
+        if (++bl_time_sync.window >= BL_TIME_SYNC_WINDOW) {
+            if (bl_time_sync.stats.synced) {
+                /* Continue from the offset in use, slew in the difference */
+                current = bl_time_sync_offset_at(bl_time_sync.best_local_us);
+
+                if (bl_time_sync.best_local_us > bl_time_sync.est_local_us) {
+                    slope = ((bl_time_sync.best_offset_us - bl_time_sync.est_offset_us) *
+                             1000000000LL) /
+                            (int64_t)(bl_time_sync.best_local_us - bl_time_sync.est_local_us);
+                    bl_time_sync.drift_ppb += (int32_t)((slope - bl_time_sync.drift_ppb) / 4);
+                }
+
+                bl_time_sync.offset_us = current;
+                bl_time_sync.slew_us = bl_time_sync.best_offset_us - current;
+            } else {
+                bl_time_sync.offset_us = bl_time_sync.best_offset_us;
+                bl_time_sync.slew_us = 0;
+            }
+
+            bl_time_sync.base_us = bl_time_sync.best_local_us;
+            bl_time_sync.est_offset_us = bl_time_sync.best_offset_us;
+            bl_time_sync.est_local_us = bl_time_sync.best_local_us;
+            bl_time_sync.window = 0;
+
+            bl_time_sync.stats.synced = true;
+            bl_time_sync.stats.offset_us = bl_time_sync.best_offset_us;
+            bl_time_sync.stats.drift_ppb = bl_time_sync.drift_ppb;
+            bl_time_sync.stats.rtt_us = bl_time_sync.best_rtt_us;
+            bl_time_sync.stats.updates++;
+        }
+    }
+
+    k_spin_unlock(&bl_time_sync.lock, key);
+#else
+    ARG_UNUSED(sync);
+    ARG_UNUSED(rx_local_us);
+#endif
+}
+
+/**
+ * @brief Get the state of the M4 clock estimate (all zero on M7)
+ */
+void bl_ipc_get_time_sync_stats(bl_time_sync_stats_t *stats)
+{
+    k_spinlock_key_t key;
+
+    if (!stats) {
+        return;
+    }
+
+    key = k_spin_lock(&bl_time_sync.lock);
+    *stats = bl_time_sync.stats;
+    k_spin_unlock(&bl_time_sync.lock, key);
+}
+
+/**
+ * @brief Log the state of the M4 clock estimate
+ */
+void bl_ipc_log_time_sync_stats(void)
+{
+    bl_time_sync_stats_t stats;
+
+    bl_ipc_get_time_sync_stats(&stats);
+
+    if (!stats.synced) {
+        LOG_INF("Time sync: not synced (%u replies)", stats.exchanges);
+        return;
+    }
+
+    LOG_INF("Time sync: offset %lld us, drift %d ppb, rtt %u us, %u updates",
+            (long long)stats.offset_us, stats.drift_ppb, stats.rtt_us, stats.updates);
 }
 
 /**
@@ -11,6 +11,8 @@
 Includes
 ****/
 #include <zephyr/kernel.h>
+#include <zephyr/devicetree.h>
+#include <zephyr/linker/section_tags.h>
 
 /****
 Macro definitions
@@ -45,10 +47,217 @@ Macro definitions
 #define BL_THREAD_PRIORITY_LOW       15
 #define BL_THREAD_PRIORITY_IDLE      20
 
+/* Rate group criticality: low-criticality groups are shed while the core
+ * is overloaded so that the high-criticality groups keep their deadlines
+ */
+#define BL_OS_CRIT_LOW           0U
+#define BL_OS_CRIT_HIGH          1U
+
+/* Rate groups run by the executive:
+ * X(ID, period_ms, offset_ms, priority, stack_size, deadline_ms, budget_us, criticality)
+ * Priorities are rate monotonic, the shorter the period the higher the
+ * priority. Group ID is released at ticks offset_ms + k * period_ms; the
+ * offsets are chosen so that no two groups other than the 1ms group are ever
+ * released on the same tick. A run must complete within deadline_ms of its
+ * release (at most period_ms) and take at most budget_us from its start to
+ * its end, preemption by higher-priority groups included.
+ * The budgets add up to 60% of each core.
+ */
+#define BL_OS_RATE_GROUP_TABLE(X) \
+    X(1MS,     1U,    0U,  1, BL_THREAD_STACK_SIZE_SMALL,  1U,    100U,   BL_OS_CRIT_HIGH) \
+    X(5MS,     5U,    1U,  2, BL_THREAD_STACK_SIZE_MEDIUM, 5U,    500U,   BL_OS_CRIT_HIGH) \
+    X(10MS,    10U,   2U,  3, BL_THREAD_STACK_SIZE_MEDIUM, 10U,   1000U,  BL_OS_CRIT_HIGH) \
+    X(20MS,    20U,   3U,  4, BL_THREAD_STACK_SIZE_MEDIUM, 20U,   1000U,  BL_OS_CRIT_HIGH) \
+    X(50MS,    50U,   4U,  5, BL_THREAD_STACK_SIZE_MEDIUM, 50U,   2500U,  BL_OS_CRIT_HIGH) \
+    X(100MS,   100U,  5U,  6, BL_THREAD_STACK_SIZE_LARGE,  100U,  5000U,  BL_OS_CRIT_HIGH) \
+    X(200MS,   200U,  10U, 7, BL_THREAD_STACK_SIZE_LARGE,  200U,  10000U, BL_OS_CRIT_LOW)  \
+    X(500MS,   500U,  15U, 8, BL_THREAD_STACK_SIZE_LARGE,  500U,  25000U, BL_OS_CRIT_LOW)  \
+    X(1000MS,  1000U, 20U, 9, BL_THREAD_STACK_SIZE_LARGE,  1000U, 50000U, BL_OS_CRIT_LOW)
+
+/* Low-criticality groups stay shed for this long after the last deadline
+ * miss or budget overrun of a high-criticality group
+ */
+#define BL_OS_SHED_HOLD_MS       1000U
+
+/* Major frame of the executive: every rate group period divides it */
+#define BL_OS_EXEC_MAJOR_FRAME_MS    1000U
+
+/* Cyclic executive: all rate groups run in one thread, non-preemptively,
+ * in a fixed order. Saves the per-group threads and stacks; all work due
+ * in a 1ms frame must then fit in the frame. Used on M4, where the groups
+ * only do microseconds of work.
+ */
+#if defined(CORE_CM4)
+#define BL_OS_EXEC_CYCLIC        1
+#else
+#define BL_OS_EXEC_CYCLIC        0
+#endif
+
+/* Stack of the cyclic executive thread, which runs every rate group */
+#define BL_OS_EXEC_CYCLIC_STACK_SIZE BL_THREAD_STACK_SIZE_LARGE
+
+/* Threads created through the OSAL: the cyclic executive only needs one */
+#if BL_OS_EXEC_CYCLIC
+#define BL_OS_NUM_OSAL_THREADS   1U
+#else
+#define BL_OS_NUM_OSAL_THREADS   BL_OS_MAX_NUM_THREADS
+#endif
+
+/* Stack usage monitor: peak usage of up to BL_OS_STACK_MAX_THREADS threads,
+ * sampled every BL_OS_STACK_SAMPLE_MS. Needs CONFIG_INIT_STACKS,
+ * CONFIG_THREAD_STACK_INFO and CONFIG_THREAD_MONITOR.
+ */
+#define BL_OS_STACK_MAX_THREADS  32U
+#define BL_OS_STACK_NAME_LEN     16U
+#define BL_OS_STACK_SAMPLE_MS    1000U
+#define BL_OS_STACK_WARN_PERCENT 90U    /* Peak usage logged as a warning */
+
+/* Message buffer pools: fixed-size blocks in size classes, smallest first:
+ * X(ID, block_size, blocks)
+ * Blocks are cache-line aligned and a multiple of the cache line, so a
+ * buffer never shares a line with another. MEDIUM holds a full
+ * bl_ipc_msg_t.
+ */
+#define BL_OS_BUF_ALIGN          32U
+#define BL_OS_BUF_CLASS_TABLE(X) \
+    X(SMALL,   64U,   32U) \
+    X(MEDIUM,  288U,  16U) \
+    X(LARGE,   1024U, 8U)
+
+/* OSAL queues: record alignment of by-reference queues */
+#define BL_OS_QUEUE_ALIGN        8U
+
+/* Statically backed OSAL queue: the ring of queue entries and, for a
+ * by-reference queue, the pool of its records. Initialize it with
+ * bl_osal_queue_init() before use.
+ */
+#define BL_OSAL_QUEUE_DEFINE(name, queue_mode, queue_length, size) \
+    static char __aligned(BL_OS_QUEUE_ALIGN) name##_ring[(queue_length) * \
+        (((queue_mode) == BL_OSAL_QUEUE_BY_REF) ? sizeof(void *) : (size))]; \
+    static char __aligned(BL_OS_QUEUE_ALIGN) name##_pool[ \
+        ((queue_mode) == BL_OSAL_QUEUE_BY_REF) ? \
+        (queue_length) * ROUND_UP(size, BL_OS_QUEUE_ALIGN) : 1]; \
+    static const bl_osal_queue_cfg_t name##_cfg = { \
+        .mode = (queue_mode), \
+        .length = (queue_length), \
+        .item_size = (size), \
+        .ring = name##_ring, \
+        .pool = name##_pool, \
+    }; \
+    bl_osal_queue_t name = { .cfg = &name##_cfg }
+
+/* Interrupt framework: ISRs registered for statistics, stack and priority
+ * of the category 2 handler threads. The default priority is above every
+ * rate group.
+ */
+#define BL_OS_ISR_MAX                8U
+#define BL_OS_ISR_STACK_SIZE         BL_THREAD_STACK_SIZE_SMALL
+#define BL_OS_ISR_THREAD_PRIORITY    0
+
+/* Category 1 ISR: the handler runs in interrupt context */
+#define BL_OSAL_ISR_CAT1_DEFINE(isr_name, fn, fn_arg) \
+    static const bl_osal_isr_cfg_t isr_name##_cfg = { \
+        .name = #isr_name, \
+        .category = BL_OSAL_ISR_CAT1, \
+        .handler = (fn), \
+        .arg = (fn_arg), \
+    }; \
+    bl_osal_isr_t isr_name = { .cfg = &isr_name##_cfg }
+
+/* Category 2 ISR: the interrupt only gives the ISR's semaphore; the handler
+ * runs in a thread of its own at the given priority
+ */
+#define BL_OSAL_ISR_CAT2_DEFINE(isr_name, fn, fn_arg, prio) \
+    static K_THREAD_STACK_DEFINE(isr_name##_stack, BL_OS_ISR_STACK_SIZE); \
+    static const bl_osal_isr_cfg_t isr_name##_cfg = { \
+        .name = #isr_name, \
+        .category = BL_OSAL_ISR_CAT2, \
+        .handler = (fn), \
+        .arg = (fn_arg), \
+        .stack = isr_name##_stack, \
+        .stack_size = K_THREAD_STACK_SIZEOF(isr_name##_stack), \
+        .priority = (prio), \
+    }; \
+    bl_osal_isr_t isr_name = { .cfg = &isr_name##_cfg }
+
+/* Connect a vector to an ISR defined above; for interrupts owned by a
+ * driver, call bl_osal_isr_raise() from the driver's callback instead,
+ * with the profiling counter read on entry to the callback
+ */
+#define BL_OSAL_ISR_CONNECT(isr_name, irq, irq_prio) \
+    do { \
+        IRQ_CONNECT(irq, irq_prio, bl_osal_isr_entry, &(isr_name), 0); \
+        irq_enable(irq); \
+    } while (0)
+
+/* Memory placement (linker snippets in common/linker):
+ *   BL_HOT_CODE    function run from ITCM, copied there at boot
+ *   BL_FAST_DATA   variable in DTCM
+ *   BL_DMA_BUFFER  buffer in non-cacheable memory, cache-line aligned
+ * TCM placement needs the zephyr,itcm / zephyr,dtcm chosen nodes and the
+ * non-cacheable one CONFIG_NOCACHE_MEMORY; otherwise the linker places the
+ * object as usual. Long calls between flash and ITCM go through veneers.
+ */
+#if DT_HAS_CHOSEN(zephyr_itcm) && !defined(CONFIG_ARCH_POSIX)
+#define BL_HOT_CODE              __attribute__((section(".bl_hot_code")))
+#else
+#define BL_HOT_CODE
+#endif
+
+#if DT_HAS_CHOSEN(zephyr_dtcm) && !defined(CONFIG_ARCH_POSIX)
+#define BL_FAST_DATA             __attribute__((section(".bl_fast_data")))
+#else
+#define BL_FAST_DATA
+#endif
+
+#if defined(CONFIG_NOCACHE_MEMORY)
+#define BL_DMA_BUFFER            __nocache __aligned(BL_OS_BUF_ALIGN)
+#else
+#define BL_DMA_BUFFER            __aligned(BL_OS_BUF_ALIGN)
+#endif
+
 /* IPC Configuration */
 #define BL_IPC_MSG_QUEUE_SIZE        32
 #define BL_IPC_MSG_MAX_SIZE          256
 
+/* IPC lane RX queue depths (alarm, control, bulk) */
+#define BL_IPC_ALARM_QUEUE_SIZE      8
+#define BL_IPC_CONTROL_QUEUE_SIZE    8
+#define BL_IPC_BULK_QUEUE_SIZE       BL_IPC_MSG_QUEUE_SIZE
+
+/* Longest bl_ipc_send_msg() waits for a free peer RX slot (blocking message types) */
+#define BL_IPC_CREDIT_TIMEOUT_MS     10
+
+/* Received vring buffers that may be held at once (zero-copy receive) */
+#define BL_IPC_RX_HOLD_SLOTS         16
+
+/* IPC message coalescing */
+#define BL_IPC_COALESCE_BUF_SIZE     496U    /* RPMsg buffer payload size */
+#define BL_IPC_COALESCE_DEADLINE_US  1000U   /* Longest a record waits for its batch */
+#define BL_IPC_RECORD_ALIGN          8U      /* Alignment of records in a batch (64-bit timestamp) */
+
+/* Shared timebase: M4 estimates its offset to the M7 clock from the best
+ * (shortest round trip) of BL_TIME_SYNC_WINDOW exchanges, one exchange
+ * every BL_TIME_SYNC_INTERVAL_MS. Later estimates are slewed in at
+ * BL_TIME_SYNC_SLEW_PPM instead of stepping the clock.
+ */
+#define BL_TIME_SYNC_INTERVAL_MS     125U
+#define BL_TIME_SYNC_WINDOW          8U
+#define BL_TIME_SYNC_SLEW_PPM        500
+
+/* RPC requests that may be outstanding at once, all types together */
+#define BL_RPC_MAX_PENDING           8U
+
+/* Rate group profiler histograms: bin 0 counts times below
+ * 2^BL_PROF_HIST_SHIFT cycles, bin k times in [2^(SHIFT+k-1), 2^(SHIFT+k)),
+ * the last bin everything above.
+ */
+#define BL_PROF_HIST_BINS            16U
+#define BL_PROF_HIST_SHIFT           8U
+
+/* Longest wait for the peer's profile (M7 query of M4) */
+#define BL_PROF_QUERY_TIMEOUT_MS     100U
+
 /****
 Typedef definitions
 ****/
@@ -62,6 +271,160 @@ typedef struct {
     const char *name;
 } bl_thread_config_t;
 
+/* Main function of a rate group, called once per release with its thread ID */
+typedef void (*bl_osal_group_fn_t)(uint32_t thread_id);
+
+/* Periodic task release state. Releases fall on multiples of period_ms of
+ * uptime, so tasks with related periods release together.
+ */
+typedef struct {
+    uint32_t period_ms;
+    uint64_t release;        /* Index of the next release (at release * period_ms) */
+    uint32_t cycles;         /* Calls to bl_osal_periodic_wait() */
+    uint32_t overruns;       /* Cycles that ended after the next release was due */
+    uint32_t skipped;        /* Releases dropped to get back on schedule */
+} bl_osal_periodic_t;
+
+/* Timing faults reported by the executive */
+typedef enum {
+    BL_OSAL_EXEC_DEADLINE_MISS = 0,  /* Run not complete deadline_ms after its release */
+    BL_OSAL_EXEC_BUDGET_OVERRUN,     /* Run executed for longer than budget_us */
+} bl_osal_exec_fault_t;
+
+/* Timing fault callback. Deadline misses are reported from the executive
+ * timer (interrupt context), budget overruns from the group thread.
+ */
+typedef void (*bl_osal_exec_fault_fn_t)(uint32_t thread_id, bl_osal_exec_fault_t fault);
+
+/* Executive statistics of one rate group */
+typedef struct {
+    uint32_t releases;       /* Releases by the executive timer */
+    uint32_t activations;    /* Completed runs of the group main function */
+    uint32_t overruns;       /* Releases while the previous one was pending or running */
+    uint32_t deadline_misses;
+    uint32_t budget_overruns;
+    uint32_t shed;           /* Releases skipped while shedding load */
+    uint32_t jitter_max_us;  /* Latest start after the nominal release time */
+    uint64_t jitter_total_us;
+    uint32_t exec_max_us;    /* Longest run of the group main function */
+} bl_osal_exec_stats_t;
+
+/* Execution profile of one rate group, in profiling counter cycles */
+typedef struct {
+    uint32_t cycle_rate;     /* Counter frequency, Hz */
+    uint32_t count;          /* Profiled runs */
+    uint32_t exec_min;
+    uint32_t exec_max;
+    uint64_t exec_total;
+    uint32_t jitter_max;     /* Deviation of start-to-start interval from the period */
+    uint64_t jitter_total;
+    uint32_t exec_hist[BL_PROF_HIST_BINS];
+    uint32_t jitter_hist[BL_PROF_HIST_BINS];
+} bl_osal_prof_stats_t;
+
+/* Stack usage of one thread */
+typedef struct {
+    char name[BL_OS_STACK_NAME_LEN];
+    uint32_t size;           /* Stack size, bytes */
+    uint32_t peak;           /* Highest usage seen, bytes */
+} bl_osal_stack_info_t;
+
+/* Buffer pool size classes */
+#define BL_OS_BUF_CLASS_ENUM(ID, block_size, blocks) BL_OS_BUF_CLASS_##ID,
+
+typedef enum {
+    BL_OS_BUF_CLASS_TABLE(BL_OS_BUF_CLASS_ENUM)
+    BL_OS_BUF_CLASS_MAX
+} bl_osal_buf_class_t;
+
+/* Buffer pool statistics of one size class */
+typedef struct {
+    uint32_t block_size;
+    uint32_t blocks;
+    uint32_t used;           /* Blocks allocated now */
+    uint32_t used_max;       /* High-water mark of used */
+    uint32_t allocs;         /* Allocations served from this class */
+    uint32_t exhausted;      /* Allocations that found this class empty */
+} bl_osal_buf_stats_t;
+
+/* ISR categories */
+typedef enum {
+    BL_OSAL_ISR_CAT1 = 1,    /* Handler in interrupt context */
+    BL_OSAL_ISR_CAT2,        /* Handler deferred to the ISR's thread */
+} bl_osal_isr_cat_t;
+
+typedef void (*bl_osal_isr_fn_t)(void *arg);
+
+/* ISR configuration (see BL_OSAL_ISR_CAT1_DEFINE / BL_OSAL_ISR_CAT2_DEFINE) */
+typedef struct {
+    const char *name;
+    bl_osal_isr_cat_t category;
+    bl_osal_isr_fn_t handler;
+    void *arg;
+    k_thread_stack_t *stack;     /* Category 2 only */
+    size_t stack_size;
+    int priority;
+} bl_osal_isr_cfg_t;
+
+/* ISR statistics, in profiling counter cycles */
+typedef struct {
+    uint32_t cycle_rate;     /* Counter frequency, Hz */
+    uint32_t raised;         /* Interrupts taken */
+    uint32_t handled;        /* Handler runs */
+    uint32_t merged;         /* Category 2: interrupts taken while one was pending */
+    uint32_t latency_max;    /* Interrupt entry to handler start */
+    uint64_t latency_total;
+    uint32_t exec_max;       /* Longest handler run */
+} bl_osal_isr_stats_t;
+
+/* ISR */
+typedef struct {
+    const bl_osal_isr_cfg_t *cfg;
+    struct k_sem sem;
+    struct k_thread thread;
+    struct k_spinlock lock;
+    bool pending;
+    uint32_t raised_at;      /* Cycle count of the interrupt pending */
+    bl_osal_isr_stats_t stats;
+} bl_osal_isr_t;
+
+/* OSAL queue modes */
+typedef enum {
+    BL_OSAL_QUEUE_BY_VALUE = 0,  /* Items are copied into and out of the queue */
+    BL_OSAL_QUEUE_BY_REF,        /* Records come from the queue's pool, only pointers are queued */
+} bl_osal_queue_mode_t;
+
+/* OSAL queue configuration and static storage (see BL_OSAL_QUEUE_DEFINE) */
+typedef struct {
+    bl_osal_queue_mode_t mode;
+    uint32_t length;         /* Entries of the queue, records of the pool */
+    uint32_t item_size;      /* Bytes per item or record */
+    char *ring;
+    char *pool;
+} bl_osal_queue_cfg_t;
+
+/* OSAL queue statistics */
+typedef struct {
+    uint32_t sent;
+    uint32_t received;
+    uint32_t send_timeouts;  /* Sends that found the queue full until the timeout */
+    uint32_t recv_timeouts;  /* Receives that found the queue empty until the timeout */
+    uint32_t depth;          /* Entries queued now */
+    uint32_t depth_max;      /* High-water mark of depth */
+    uint32_t records;        /* By-reference: records allocated and not freed */
+    uint32_t records_max;    /* High-water mark of records */
+    uint32_t alloc_failures; /* By-reference: allocations that found the pool empty */
+} bl_osal_queue_stats_t;
+
+/* OSAL queue */
+typedef struct {
+    const bl_osal_queue_cfg_t *cfg;
+    struct k_msgq msgq;
+    struct k_mem_slab pool;
+    struct k_spinlock lock;
+    bl_osal_queue_stats_t stats;
+} bl_osal_queue_t;
+
 /* OSAL initialization structure */
 typedef struct {
     bool initialized;
@@ -86,13 +449,93 @@ extern int bl_osal_create_thread(bl_thread_config_t *config, k_thread_entry_t en
 extern int bl_osal_start_thread(uint32_t thread_id);
 extern int bl_osal_stop_thread(uint32_t thread_id);
 
+/* Rate group executive: releases the group main functions (indexed by
+ * BL_OS_THREAD_*_ID, NULL for none) on the BL_OS_RATE_GROUP_TABLE schedule
+ */
+extern int bl_osal_exec_start(const bl_osal_group_fn_t mains[BL_OS_MAX_NUM_THREADS]);
+extern int bl_osal_exec_get_stats(uint32_t thread_id, bl_osal_exec_stats_t *stats);
+extern void bl_osal_exec_log_stats(void);
+extern void bl_osal_exec_set_fault_handler(bl_osal_exec_fault_fn_t handler);
+extern bool bl_osal_exec_is_shedding(void);
+
+/* Periodic tasks on absolute release times: call wait at the end of each cycle */
+extern int bl_osal_periodic_init(bl_osal_periodic_t *periodic, uint32_t period_ms);
+extern int bl_osal_periodic_wait(bl_osal_periodic_t *periodic);
+
+/* Rate group profiler: DWT cycle counter on target, system clock cycles otherwise */
+extern int bl_osal_prof_init(void);
+extern uint32_t bl_osal_prof_get_cycles(void);
+extern uint32_t bl_osal_prof_get_cycle_rate(void);
+extern void bl_osal_prof_begin(uint32_t thread_id, uint32_t period_ms);
+extern void bl_osal_prof_end(uint32_t thread_id);
+extern int bl_osal_prof_get_stats(uint32_t thread_id, bl_osal_prof_stats_t *stats);
+extern int bl_osal_prof_query_peer(uint32_t thread_id, bl_osal_prof_stats_t *stats);
+extern void bl_osal_prof_reset(void);
+
+/* Stack usage monitor: get returns the number of threads tracked */
+extern int bl_osal_stack_init(void);
+extern void bl_osal_stack_sample(void);
+extern int bl_osal_stack_get(uint32_t index, bl_osal_stack_info_t *info);
+extern int bl_osal_stack_query_peer(uint32_t index, bl_osal_stack_info_t *info);
+
+/* Interrupt framework. Initialize an ISR before its interrupt is enabled;
+ * bl_osal_isr_entry() is the vector, bl_osal_isr_raise() the call from a
+ * driver callback, both in interrupt context. entry is
+ * bl_osal_prof_get_cycles() read first thing in the interrupt.
+ */
+extern int bl_osal_isr_init(bl_osal_isr_t *isr);
+extern void bl_osal_isr_entry(const void *arg);
+extern void bl_osal_isr_raise(bl_osal_isr_t *isr, uint32_t entry);
+extern int bl_osal_isr_get_stats(bl_osal_isr_t *isr, bl_osal_isr_stats_t *stats);
+extern void bl_osal_isr_log_stats(void);
+
+/* Message buffer pools. A buffer comes from the smallest class it fits,
+ * from a larger class if that one is empty, with one reference. Every
+ * further consumer takes a reference; the last unref frees the buffer.
+ */
+extern int bl_osal_buf_init(void);
+extern void *bl_osal_buf_alloc(size_t size, k_timeout_t timeout);
+extern void *bl_osal_buf_ref(void *buf);
+extern void bl_osal_buf_unref(void *buf);
+extern size_t bl_osal_buf_size(const void *buf);
+extern int bl_osal_buf_get_stats(uint32_t class_id, bl_osal_buf_stats_t *stats);
+extern void bl_osal_buf_log_stats(void);
+
+/* Queues. By value: send/recv copy items. By reference: alloc a record,
+ * fill it and send_ref it; the receiver owns it after recv_ref and frees
+ * it. Timeouts return -EAGAIN.
+ */
+extern int bl_osal_queue_init(bl_osal_queue_t *queue);
+extern int bl_osal_queue_send(bl_osal_queue_t *queue, const void *item, k_timeout_t timeout);
+extern int bl_osal_queue_recv(bl_osal_queue_t *queue, void *item, k_timeout_t timeout);
+extern int bl_osal_queue_alloc(bl_osal_queue_t *queue, void **record, k_timeout_t timeout);
+extern int bl_osal_queue_send_ref(bl_osal_queue_t *queue, void *record, k_timeout_t timeout);
+extern int bl_osal_queue_recv_ref(bl_osal_queue_t *queue, void **record, k_timeout_t timeout);
+extern void bl_osal_queue_free(bl_osal_queue_t *queue, void *record);
+extern int bl_osal_queue_get_stats(bl_osal_queue_t *queue, bl_osal_queue_stats_t *stats);
+
 /* Synchronization */
 extern int bl_osal_delay_ms(uint32_t ms);
 extern uint32_t bl_osal_get_tick_ms(void);
 
-/* IPC functions */
+/* Time base: 64-bit microseconds. Local time is this core's clock; shared
+ * time is the M7 clock, on M4 estimated from the local clock.
+ */
+extern uint64_t bl_osal_get_local_time_us(void);
+extern uint64_t bl_osal_get_time_us(void);
+extern uint64_t bl_osal_local_to_shared_us(uint64_t local_us);
+
+/* IPC functions (one endpoint and RX queue per lane) */
 extern int bl_osal_ipc_init(void);
-extern int bl_osal_ipc_send(void *data, size_t len);
-extern int bl_osal_ipc_recv(void *data, size_t len, k_timeout_t timeout);
+extern int bl_osal_ipc_send(uint32_t lane, void *data, size_t len);
+extern int bl_osal_ipc_recv(uint32_t lane, void *data, size_t len, k_timeout_t timeout);
+extern struct k_msgq* bl_osal_ipc_get_rx_queue(uint32_t lane);
+extern int bl_osal_ipc_hold_rx_buffer(uint32_t lane, const void *data);
+extern int bl_osal_ipc_release_rx_buffer(uint32_t lane, const void *data);
+
+/* Zero-copy IPC functions (buffer borrowed from the shared-memory vring) */
+extern int bl_osal_ipc_get_tx_buffer(uint32_t lane, void **data, uint32_t *size, k_timeout_t timeout);
+extern int bl_osal_ipc_send_nocopy(uint32_t lane, const void *data, size_t len);
+extern int bl_osal_ipc_drop_tx_buffer(uint32_t lane, const void *data);
 
 #endif /* BL_ZEPHYR_OSAL_CFG_H_ */
\ No newline at end of file
@@ -0,0 +1,143 @@
+#!/usr/bin/env python3
+#
+# Build-time report of the objects placed with BL_HOT_CODE, BL_FAST_DATA and
+# BL_DMA_BUFFER: reads the linker map file and lists, per memory region, the
+# symbols that landed there with their address and size.
+#
+# Usage: bl_placement_report.py <zephyr.map> [<report.txt>]
+
+import re
+import sys
+
+# Input sections of the placement macros
+PLACED_SECTIONS = {
+    ".bl_hot_code": "BL_HOT_CODE",
+    ".bl_fast_data": "BL_FAST_DATA",
+    ".nocache": "BL_DMA_BUFFER",
+}
+
+REGION_RE = re.compile(r"^(\S+)\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)")
+SECTION_RE = re.compile(r"^ (\.\S+)(?:\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(.+))?$")
+CONTINUED_RE = re.compile(r"^\s+0x([0-9a-fA-F]+)\s+0x([0-9a-fA-F]+)\s+(.+)$")
+SYMBOL_RE = re.compile(r"^\s+0x([0-9a-fA-F]+)\s+([A-Za-z_]\w*)$")
+
+
+def placed_macro(section):
+    for prefix, macro in PLACED_SECTIONS.items():
+        if section == prefix or section.startswith(prefix + "."):
+            return macro
+    return None
+
+
+def parse_map(lines):
+    regions = []
+    entries = []
+    current = None
+    pending = None
+    in_memory = False
+
+    for line in lines:
+        line = line.rstrip("\n")
+
+        if line.startswith("Memory Configuration"):
+            in_memory = True
+            continue
+        if line.startswith("Linker script and memory map"):
+            in_memory = False
+            continue
+        if in_memory:
+            m = REGION_RE.match(line)
+            if m and m.group(1) not in ("Name", "*default*"):
+                regions.append((m.group(1), int(m.group(2), 16), int(m.group(3), 16)))
+            continue
+
+        if pending is not None:
+            m = CONTINUED_RE.match(line)
+            pending_section, pending = pending, None
+            if m:
+                current = {
+                    "section": pending_section,
+                    "addr": int(m.group(1), 16),
+                    "size": int(m.group(2), 16),
+                    "object": m.group(3).strip(),
+                    "symbols": [],
+                }
+                entries.append(current)
+                continue
+
+        m = SECTION_RE.match(line)
+        if m:
+            current = None
+            if not placed_macro(m.group(1)):
+                continue
+            if m.group(2) is None:
+                pending = m.group(1)
+                continue
+            current = {
+                "section": m.group(1),
+                "addr": int(m.group(2), 16),
+                "size": int(m.group(3), 16),
+                "object": m.group(4).strip(),
+                "symbols": [],
+            }
+            entries.append(current)
+            continue
+
+        m = SYMBOL_RE.match(line)
+        if m and current is not None:
+            current["symbols"].append(m.group(2))
+        elif not line.startswith(" "):
+            current = None
+
+    return regions, [e for e in entries if e["size"] > 0]
+
+
+def region_of(regions, addr):
+    for name, origin, length in regions:
+        if origin <= addr < origin + length:
+            return name
+    return "?"
+
+
+def report(regions, entries):
+    out = ["Placement report (BL_HOT_CODE / BL_FAST_DATA / BL_DMA_BUFFER)", ""]
+    totals = {}
+
+    if not entries:
+        out.append("Nothing placed")
+        return out
+
+    out.append("%-10s %-14s %-10s %8s  %s" % ("region", "macro", "address", "size", "symbols (object)"))
+    for e in sorted(entries, key=lambda e: e["addr"]):
+        region = region_of(regions, e["addr"])
+        totals[region] = totals.get(region, 0) + e["size"]
+        symbols = ", ".join(e["symbols"]) or e["section"]
+        out.append("%-10s %-14s 0x%08x %8d  %s (%s)" %
+                   (region, placed_macro(e["section"]), e["addr"], e["size"], symbols,
+                    e["object"].split("/")[-1]))
+
+    out.append("")
+    for name, origin, length in regions:
+        if name in totals:
+            out.append("%-10s %8d of %d bytes placed" % (name, totals[name], length))
+
+    return out
+
+
+def main():
+    if len(sys.argv) < 2:
+        sys.exit("usage: %s <map file> [<report file>]" % sys.argv[0])
+
+    with open(sys.argv[1]) as f:
+        regions, entries = parse_map(f)
+
+    text = "\n".join(report(regions, entries)) + "\n"
+    print(text, end="")
+
+    if len(sys.argv) > 2:
+        with open(sys.argv[2], "w") as f:
+            f.write(text)
+
+
+if __name__ == "__main__":
+    main()
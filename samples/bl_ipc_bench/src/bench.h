@@ -0,0 +1,15 @@
+/*
+ * blue_leap IPC benchmark suites
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef BENCH_H__
+#define BENCH_H__
+
+/* bl_isw message API over the configured IPC service backend */
+void bench_ipc_init(void);
+void bench_ipc_run(void);
+void bench_ipc_serve(void);
+
+#endif /* BENCH_H__ */
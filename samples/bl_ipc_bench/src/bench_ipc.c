@@ -0,0 +1,351 @@
+/*
+ * Message benchmarks of the bl_isw IPC API
+ *
+ * The initiator sends requests on the control lane and bulk data on the
+ * bulk lane; a server answers on the alarm lane. With the loopback backend
+ * (native_sim) initiator and server run in the same image; on the
+ * MIMXRT1160-EVK the M7 image is the initiator and the M4 image the server,
+ * talking over RPMsg.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bl_isw.h"
+#include "bl_zephyr_osal_cfg.h"
+#include "bench.h"
+#include "bench_time.h"
+
+#ifdef BL_IPC_LOOPBACK
+#define BENCH_BACKEND		"loopback"
+#else
+#define BENCH_BACKEND		"rpmsg"
+#endif
+
+#define BENCH_STACK_SIZE	2048
+#define SERVER_PRIORITY		4
+#define PRODUCER_PRIORITY	5
+
+/* Ping-pong */
+#define PINGPONG_WARMUP		100U
+#define PINGPONG_ITERATIONS	5000U
+#define HIST_BUCKETS		32U	/* log2(ns) */
+
+/* Throughput and contention */
+#define THROUGHPUT_MESSAGES	20000U
+#define MAX_PRODUCERS		4U
+
+#define REPLY_TIMEOUT		K_SECONDS(1)
+#define SINK_TIMEOUT		K_SECONDS(30)
+
+/* Requests (DIAG_REQUEST) and replies (DIAG_REPLY) start with this header */
+enum bench_cmd {
+	BENCH_CMD_ECHO = 1,	/* Reply with the request payload */
+	BENCH_CMD_SINK,		/* Count the next 'count' bulk messages, then report */
+};
+
+struct bench_hdr {
+	uint32_t cmd;
+	uint32_t count;		/* SINK: messages expected / received */
+	uint32_t bytes;		/* SINK report: payload bytes received */
+};
+
+K_THREAD_STACK_DEFINE(server_ctrl_stack, BENCH_STACK_SIZE);
+K_THREAD_STACK_DEFINE(server_sink_stack, BENCH_STACK_SIZE);
+K_THREAD_STACK_ARRAY_DEFINE(ipc_producer_stacks, MAX_PRODUCERS, BENCH_STACK_SIZE);
+static struct k_thread server_ctrl_thread;
+static struct k_thread server_sink_thread;
+static struct k_thread ipc_producer_threads[MAX_PRODUCERS];
+
+/* Server sink state, armed by BENCH_CMD_SINK before any bulk message */
+static uint32_t sink_expected;
+static uint32_t sink_received;
+static uint32_t sink_bytes;
+
+/* Initiator state */
+static uint32_t pingpong_ns[PINGPONG_ITERATIONS];
+static uint32_t producer_payload;
+static atomic_t producer_retries;
+
+/*
+ * Server side
+ */
+
+static void server_reply(const struct bench_hdr *hdr, bl_ipc_msg_t *msg)
+{
+	msg->msg_type = BL_MSG_TYPE_DIAG_REPLY;
+	memcpy(msg->data, hdr, sizeof(*hdr));
+	msg->data_len = MAX(msg->data_len, sizeof(*hdr));
+
+	if (bl_ipc_send_msg(msg) != 0) {
+		printk("server: reply lost\n");
+	}
+}
+
+static void server_ctrl(void *p1, void *p2, void *p3)
+{
+	struct bench_hdr hdr;
+	bl_ipc_msg_t msg;
+
+	while (1) {
+		if (bl_ipc_recv_lane_msg(BL_IPC_LANE_CONTROL, &msg, K_FOREVER) != 0 ||
+		    msg.msg_type != BL_MSG_TYPE_DIAG_REQUEST || msg.data_len < sizeof(hdr)) {
+			continue;
+		}
+
+		memcpy(&hdr, msg.data, sizeof(hdr));
+
+		switch (hdr.cmd) {
+		case BENCH_CMD_ECHO:
+			server_reply(&hdr, &msg);
+			break;
+
+		case BENCH_CMD_SINK:
+			sink_expected = hdr.count;
+			sink_received = 0;
+			sink_bytes = 0;
+			msg.data_len = sizeof(hdr);
+			server_reply(&hdr, &msg);
+			break;
+
+		default:
+			break;
+		}
+	}
+}
+
+static void server_sink(void *p1, void *p2, void *p3)
+{
+	struct bench_hdr hdr = { .cmd = BENCH_CMD_SINK };
+	bl_ipc_msg_t msg;
+
+	while (1) {
+		if (bl_ipc_recv_lane_msg(BL_IPC_LANE_BULK, &msg, K_FOREVER) != 0) {
+			continue;
+		}
+
+		sink_received++;
+		sink_bytes += msg.data_len;
+
+		if (sink_received == sink_expected) {
+			hdr.count = sink_received;
+			hdr.bytes = sink_bytes;
+			msg.data_len = sizeof(hdr);
+			server_reply(&hdr, &msg);
+		}
+	}
+}
+
+/*
+ * Initiator side
+ */
+
+static int request(uint32_t cmd, uint32_t count, uint32_t payload,
+		   struct bench_hdr *reply, k_timeout_t timeout)
+{
+	struct bench_hdr hdr = { .cmd = cmd, .count = count };
+	bl_ipc_msg_t msg;
+	int ret;
+
+	msg.msg_type = BL_MSG_TYPE_DIAG_REQUEST;
+	msg.data_len = MAX(payload, sizeof(hdr));
+	memset(msg.data, 0xA5, msg.data_len);
+	memcpy(msg.data, &hdr, sizeof(hdr));
+
+	ret = bl_ipc_send_msg(&msg);
+	if (ret != 0) {
+		return ret;
+	}
+
+	ret = bl_ipc_recv_lane_msg(BL_IPC_LANE_ALARM, &msg, timeout);
+	if (ret != 0) {
+		return ret;
+	}
+
+	memcpy(reply, msg.data, sizeof(*reply));
+	return (reply->cmd == cmd) ? 0 : -EBADMSG;
+}
+
+static int cmp_u32(const void *a, const void *b)
+{
+	uint32_t x = *(const uint32_t *)a;
+	uint32_t y = *(const uint32_t *)b;
+
+	return (x > y) - (x < y);
+}
+
+static void bench_pingpong(uint32_t payload)
+{
+	uint32_t hist[HIST_BUCKETS] = { 0 };
+	struct bench_hdr reply;
+	uint64_t start, total = 0;
+	uint32_t done = 0;
+	uint32_t last = 0;
+	int ret = 0;
+
+	for (uint32_t i = 0; i < PINGPONG_WARMUP && ret == 0; i++) {
+		ret = request(BENCH_CMD_ECHO, 0, payload, &reply, REPLY_TIMEOUT);
+	}
+
+	for (; done < PINGPONG_ITERATIONS && ret == 0; done++) {
+		start = bench_time_ns();
+		ret = request(BENCH_CMD_ECHO, 0, payload, &reply, REPLY_TIMEOUT);
+		pingpong_ns[done] = (uint32_t)MIN(bench_time_ns() - start, UINT32_MAX);
+	}
+	if (ret != 0 && done > 0) {
+		/* The failed request is not a sample */
+		done--;
+	}
+
+	for (uint32_t i = 0; i < done; i++) {
+		uint32_t bucket = pingpong_ns[i] ? 31U - __builtin_clz(pingpong_ns[i]) : 0U;
+
+		hist[bucket]++;
+		total += pingpong_ns[i];
+		last = MAX(last, bucket);
+	}
+
+	qsort(pingpong_ns, done, sizeof(pingpong_ns[0]), cmp_u32);
+
+	printk("{\"bench\":\"pingpong\",\"backend\":\"%s\",\"payload\":%u,\"iterations\":%u,"
+	       "\"min_ns\":%u,\"p50_ns\":%u,\"p99_ns\":%u,\"max_ns\":%u,\"avg_ns\":%llu,"
+	       "\"hist_log2_ns\":[",
+	       BENCH_BACKEND, payload, done,
+	       done ? pingpong_ns[0] : 0U,
+	       done ? pingpong_ns[done / 2] : 0U,
+	       done ? pingpong_ns[(done * 99U) / 100U] : 0U,
+	       done ? pingpong_ns[done - 1] : 0U,
+	       done ? total / done : 0U);
+	for (uint32_t i = 0; i <= last; i++) {
+		printk("%s%u", i ? "," : "", hist[i]);
+	}
+	printk("],\"ok\":%s}\n", (ret == 0) ? "true" : "false");
+}
+
+static void ipc_producer(void *p1, void *p2, void *p3)
+{
+	uint32_t count = POINTER_TO_UINT(p1);
+	bl_ipc_msg_t msg;
+
+	msg.msg_type = BL_MSG_TYPE_DIAG_BULK;
+	msg.data_len = producer_payload;
+	memset(msg.data, 0x5A, producer_payload);
+
+	for (uint32_t i = 0; i < count; i++) {
+		/* Bulk diagnostics are dropped rather than queued when the peer has no
+		 * credit left; back off a tick (not a yield, simulated time must
+		 * advance for the coalescing deadline to fire) and resend.
+		 */
+		while (bl_ipc_send_msg(&msg) != 0) {
+			atomic_inc(&producer_retries);
+			k_sleep(K_TICKS(1));
+		}
+	}
+}
+
+static void bench_throughput(uint32_t payload, uint32_t producers)
+{
+	uint32_t per_producer = THROUGHPUT_MESSAGES / producers;
+	uint32_t messages = per_producer * producers;
+	bl_ipc_tx_stats_t before, after;
+	struct bench_hdr reply;
+	bl_ipc_msg_t report;
+	uint64_t start, elapsed;
+	uint32_t sent;
+	int ret;
+
+	ret = request(BENCH_CMD_SINK, messages, 0, &reply, REPLY_TIMEOUT);
+	if (ret != 0) {
+		printk("{\"bench\":\"throughput\",\"backend\":\"%s\",\"payload\":%u,"
+		       "\"producers\":%u,\"ok\":false}\n", BENCH_BACKEND, payload, producers);
+		return;
+	}
+
+	producer_payload = payload;
+	atomic_set(&producer_retries, 0);
+	bl_ipc_get_tx_stats(&before);
+
+	start = bench_time_ns();
+
+	for (uint32_t i = 0; i < producers; i++) {
+		k_thread_create(&ipc_producer_threads[i], ipc_producer_stacks[i],
+				K_THREAD_STACK_SIZEOF(ipc_producer_stacks[i]), ipc_producer,
+				UINT_TO_POINTER(per_producer), NULL, NULL,
+				PRODUCER_PRIORITY, 0, K_NO_WAIT);
+	}
+	/* Every producer has exited before the next run creates it again */
+	for (uint32_t i = 0; i < producers; i++) {
+		k_thread_join(&ipc_producer_threads[i], K_FOREVER);
+	}
+
+	/* Do not wait for the coalescing deadline of the last batch */
+	bl_ipc_flush();
+
+	/* The sink reports once it has received every message */
+	ret = bl_ipc_recv_lane_msg(BL_IPC_LANE_ALARM, &report, SINK_TIMEOUT);
+	if (ret == 0) {
+		memcpy(&reply, report.data, sizeof(reply));
+	}
+	elapsed = MAX(bench_time_ns() - start, 1U);
+
+	bl_ipc_get_tx_stats(&after);
+	sent = after.copy.msg_count - before.copy.msg_count;
+
+	printk("{\"bench\":\"throughput\",\"backend\":\"%s\",\"payload\":%u,\"producers\":%u,"
+	       "\"messages\":%u,\"ns\":%llu,\"msgs_per_sec\":%llu,\"bytes_per_sec\":%llu,"
+	       "\"buffers\":%u,\"send_cycles_avg\":%u,\"retries\":%ld,\"ok\":%s}\n",
+	       BENCH_BACKEND, payload, producers, messages, elapsed,
+	       (uint64_t)messages * NSEC_PER_SEC / elapsed,
+	       (uint64_t)messages * payload * NSEC_PER_SEC / elapsed,
+	       after.buffers_sent - before.buffers_sent,
+	       sent ? (uint32_t)((after.copy.cycles - before.copy.cycles) / sent) : 0U,
+	       (long)atomic_get(&producer_retries),
+	       (ret == 0 && sent == messages &&
+		reply.count == messages) ? "true" : "false");
+}
+
+void bench_ipc_init(void)
+{
+	int ret = bl_osal_ipc_init();
+
+	if (ret < 0) {
+		printk("IPC init failed: %d\n", ret);
+	}
+}
+
+void bench_ipc_serve(void)
+{
+	k_thread_create(&server_ctrl_thread, server_ctrl_stack,
+			K_THREAD_STACK_SIZEOF(server_ctrl_stack), server_ctrl,
+			NULL, NULL, NULL, SERVER_PRIORITY, 0, K_NO_WAIT);
+	k_thread_name_set(&server_ctrl_thread, "bench_ctrl");
+
+	k_thread_create(&server_sink_thread, server_sink_stack,
+			K_THREAD_STACK_SIZEOF(server_sink_stack), server_sink,
+			NULL, NULL, NULL, SERVER_PRIORITY, 0, K_NO_WAIT);
+	k_thread_name_set(&server_sink_thread, "bench_sink");
+}
+
+void bench_ipc_run(void)
+{
+	static const uint32_t payloads[] = { 16, 64, 128, sizeof(((bl_ipc_msg_t *)0)->data) };
+	static const uint32_t producers[] = { 1, 2, MAX_PRODUCERS };
+
+	for (size_t i = 0; i < ARRAY_SIZE(payloads); i++) {
+		bench_pingpong(payloads[i]);
+	}
+
+	/* One-way streaming throughput */
+	for (size_t i = 0; i < ARRAY_SIZE(payloads); i++) {
+		bench_throughput(payloads[i], 1);
+	}
+
+	/* Multi-producer contention on the bulk lane */
+	for (size_t i = 1; i < ARRAY_SIZE(producers); i++) {
+		bench_throughput(64, producers[i]);
+	}
+}
@@ -0,0 +1,41 @@
+/*
+ * Benchmark wall clock: host monotonic clock on native_sim, cycle counter
+ * on target.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef BENCH_TIME_H__
+#define BENCH_TIME_H__
+
+#include <zephyr/kernel.h>
+#include <zephyr/timing/timing.h>
+
+#ifdef CONFIG_ARCH_POSIX
+extern uint64_t bl_bench_host_time_ns(void);
+#endif
+
+static inline void bench_time_init(void)
+{
+#ifndef CONFIG_ARCH_POSIX
+	timing_init();
+	timing_start();
+#endif
+}
+
+static inline uint64_t bench_time_ns(void)
+{
+#ifdef CONFIG_ARCH_POSIX
+	return bl_bench_host_time_ns();
+#else
+	static timing_t origin;
+	timing_t now = timing_counter_get();
+
+	if (origin == 0) {
+		origin = now;
+	}
+	return timing_cycles_to_ns(timing_cycles_get(&origin, &now));
+#endif
+}
+
+#endif /* BENCH_TIME_H__ */
@@ -0,0 +1,330 @@
+/*
+ * Loopback IPC service backend
+ *
+ * Every endpoint receives the messages sent on it. Messages are delivered
+ * from a dedicated thread, as the RPMsg backend delivers them from its work
+ * queue, and buffers follow the same borrow/send/hold/release life cycle,
+ * so the blue_leap IPC layer runs unchanged in a single image.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#define DT_DRV_COMPAT bl_ipc_loopback
+
+#include <zephyr/kernel.h>
+#include <zephyr/device.h>
+#include <zephyr/ipc/ipc_service_backend.h>
+#include <string.h>
+
+#define LOOPBACK_EPT_MAX	8
+#define LOOPBACK_STACK_SIZE	2048
+#define LOOPBACK_PRIORITY	K_PRIO_COOP(2)
+
+struct loopback_ept {
+	const struct ipc_ept_cfg *cfg;
+};
+
+struct loopback_item {
+	struct loopback_ept *ept;
+	void *buf;
+	size_t len;
+};
+
+struct loopback_config {
+	uint8_t *pool;
+	char *items;
+	size_t buf_size;
+	uint32_t buf_count;
+	k_thread_stack_t *stack;
+	size_t stack_size;
+};
+
+struct loopback_data {
+	struct k_mem_slab slab;
+	struct k_msgq rx_queue;
+	struct k_spinlock lock;
+	struct k_thread thread;
+	struct loopback_ept epts[LOOPBACK_EPT_MAX];
+	bool *held;
+	bool *in_cb;
+	bool opened;
+};
+
+static uint32_t loopback_index(const struct device *dev, const void *buf)
+{
+	const struct loopback_config *cfg = dev->config;
+
+	return ((const uint8_t *)buf - cfg->pool) / cfg->buf_size;
+}
+
+static bool loopback_owns(const struct device *dev, const void *buf)
+{
+	const struct loopback_config *cfg = dev->config;
+	const uint8_t *p = buf;
+
+	return p >= cfg->pool && p < cfg->pool + cfg->buf_size * cfg->buf_count;
+}
+
+static void loopback_free(const struct device *dev, void *buf)
+{
+	struct loopback_data *data = dev->data;
+
+	k_mem_slab_free(&data->slab, buf);
+}
+
+static void loopback_thread(void *p1, void *p2, void *p3)
+{
+	const struct device *dev = p1;
+	struct loopback_data *data = dev->data;
+	struct loopback_item item;
+	k_spinlock_key_t key;
+	uint32_t idx;
+	bool release;
+
+	while (1) {
+		k_msgq_get(&data->rx_queue, &item, K_FOREVER);
+		idx = loopback_index(dev, item.buf);
+
+		key = k_spin_lock(&data->lock);
+		data->in_cb[idx] = true;
+		k_spin_unlock(&data->lock, key);
+
+		if (item.ept->cfg->cb.received) {
+			item.ept->cfg->cb.received(item.buf, item.len, item.ept->cfg->priv);
+		}
+
+		/* The buffer stays with the receiver if it was held and not yet released */
+		key = k_spin_lock(&data->lock);
+		data->in_cb[idx] = false;
+		release = !data->held[idx];
+		k_spin_unlock(&data->lock, key);
+
+		if (release) {
+			loopback_free(dev, item.buf);
+		}
+	}
+}
+
+static int loopback_open_instance(const struct device *dev)
+{
+	struct loopback_data *data = dev->data;
+
+	if (data->opened) {
+		return -EALREADY;
+	}
+
+	data->opened = true;
+	return 0;
+}
+
+static int loopback_register_endpoint(const struct device *dev, void **token,
+				      const struct ipc_ept_cfg *cfg)
+{
+	struct loopback_data *data = dev->data;
+
+	for (size_t i = 0; i < ARRAY_SIZE(data->epts); i++) {
+		if (data->epts[i].cfg == NULL) {
+			data->epts[i].cfg = cfg;
+			*token = &data->epts[i];
+
+			/* The remote end is this endpoint itself: bound right away */
+			if (cfg->cb.bound) {
+				cfg->cb.bound(cfg->priv);
+			}
+			return 0;
+		}
+	}
+
+	return -ENOMEM;
+}
+
+static int loopback_deregister_endpoint(const struct device *dev, void *token)
+{
+	struct loopback_ept *ept = token;
+
+	ept->cfg = NULL;
+	return 0;
+}
+
+static int loopback_get_tx_buffer_size(const struct device *dev, void *token)
+{
+	const struct loopback_config *cfg = dev->config;
+
+	return cfg->buf_size;
+}
+
+static int loopback_get_tx_buffer(const struct device *dev, void *token,
+				  void **buf, uint32_t *len, k_timeout_t wait)
+{
+	const struct loopback_config *cfg = dev->config;
+	struct loopback_data *data = dev->data;
+
+	if (*len > cfg->buf_size) {
+		*len = cfg->buf_size;
+		return -ENOMEM;
+	}
+
+	if (k_mem_slab_alloc(&data->slab, buf, wait) != 0) {
+		return -ENOBUFS;
+	}
+
+	*len = cfg->buf_size;
+	return 0;
+}
+
+static int loopback_drop_tx_buffer(const struct device *dev, void *token, const void *buf)
+{
+	if (!loopback_owns(dev, buf)) {
+		return -ENXIO;
+	}
+
+	loopback_free(dev, (void *)buf);
+	return 0;
+}
+
+static int loopback_send_nocopy(const struct device *dev, void *token,
+				const void *buf, size_t len)
+{
+	const struct loopback_config *cfg = dev->config;
+	struct loopback_data *data = dev->data;
+	struct loopback_item item = {
+		.ept = token,
+		.buf = (void *)buf,
+		.len = len,
+	};
+
+	if (!loopback_owns(dev, buf) || len > cfg->buf_size) {
+		return -EINVAL;
+	}
+
+	/* The queue has a slot per buffer, so this never waits */
+	k_msgq_put(&data->rx_queue, &item, K_FOREVER);
+	return len;
+}
+
+static int loopback_send(const struct device *dev, void *token, const void *msg, size_t len)
+{
+	const struct loopback_config *cfg = dev->config;
+	uint32_t size = cfg->buf_size;
+	void *buf;
+	int ret;
+
+	if (len > cfg->buf_size) {
+		return -EMSGSIZE;
+	}
+
+	ret = loopback_get_tx_buffer(dev, token, &buf, &size, K_FOREVER);
+	if (ret < 0) {
+		return ret;
+	}
+
+	memcpy(buf, msg, len);
+	return loopback_send_nocopy(dev, token, buf, len);
+}
+
+static int loopback_hold_rx_buffer(const struct device *dev, void *token, void *buf)
+{
+	struct loopback_data *data = dev->data;
+	k_spinlock_key_t key;
+
+	if (!loopback_owns(dev, buf)) {
+		return -ENXIO;
+	}
+
+	key = k_spin_lock(&data->lock);
+	data->held[loopback_index(dev, buf)] = true;
+	k_spin_unlock(&data->lock, key);
+
+	return 0;
+}
+
+static int loopback_release_rx_buffer(const struct device *dev, void *token, void *buf)
+{
+	struct loopback_data *data = dev->data;
+	k_spinlock_key_t key;
+	uint32_t idx;
+	bool release;
+
+	if (!loopback_owns(dev, buf)) {
+		return -ENXIO;
+	}
+
+	idx = loopback_index(dev, buf);
+
+	/* Released from inside the callback: the delivery thread frees it */
+	key = k_spin_lock(&data->lock);
+	data->held[idx] = false;
+	release = !data->in_cb[idx];
+	k_spin_unlock(&data->lock, key);
+
+	if (release) {
+		loopback_free(dev, buf);
+	}
+
+	return 0;
+}
+
+static const struct ipc_service_backend loopback_backend_ops = {
+	.open_instance = loopback_open_instance,
+	.register_endpoint = loopback_register_endpoint,
+	.deregister_endpoint = loopback_deregister_endpoint,
+	.send = loopback_send,
+	.get_tx_buffer_size = loopback_get_tx_buffer_size,
+	.get_tx_buffer = loopback_get_tx_buffer,
+	.drop_tx_buffer = loopback_drop_tx_buffer,
+	.send_nocopy = loopback_send_nocopy,
+	.hold_rx_buffer = loopback_hold_rx_buffer,
+	.release_rx_buffer = loopback_release_rx_buffer,
+};
+
+static int loopback_init(const struct device *dev)
+{
+	const struct loopback_config *cfg = dev->config;
+	struct loopback_data *data = dev->data;
+	int ret;
+
+	ret = k_mem_slab_init(&data->slab, cfg->pool, cfg->buf_size, cfg->buf_count);
+	if (ret < 0) {
+		return ret;
+	}
+
+	k_msgq_init(&data->rx_queue, cfg->items, sizeof(struct loopback_item), cfg->buf_count);
+
+	k_thread_create(&data->thread, cfg->stack, cfg->stack_size, loopback_thread,
+			(void *)dev, NULL, NULL, LOOPBACK_PRIORITY, 0, K_NO_WAIT);
+	k_thread_name_set(&data->thread, dev->name);
+
+	return 0;
+}
+
+#define LOOPBACK_BUF_SIZE(i)	ROUND_UP(DT_INST_PROP(i, buffer_size), sizeof(void *))
+#define LOOPBACK_BUF_COUNT(i)	DT_INST_PROP(i, buffer_count)
+
+#define LOOPBACK_DEFINE(i)								\
+	static uint8_t loopback_pool_##i[LOOPBACK_BUF_COUNT(i) * LOOPBACK_BUF_SIZE(i)]	\
+		__aligned(sizeof(void *));						\
+	static struct loopback_item loopback_items_##i[LOOPBACK_BUF_COUNT(i)];		\
+	static bool loopback_held_##i[LOOPBACK_BUF_COUNT(i)];				\
+	static bool loopback_in_cb_##i[LOOPBACK_BUF_COUNT(i)];				\
+	K_THREAD_STACK_DEFINE(loopback_stack_##i, LOOPBACK_STACK_SIZE);			\
+											\
+	static const struct loopback_config loopback_config_##i = {			\
+		.pool = loopback_pool_##i,						\
+		.items = (char *)loopback_items_##i,					\
+		.buf_size = LOOPBACK_BUF_SIZE(i),					\
+		.buf_count = LOOPBACK_BUF_COUNT(i),					\
+		.stack = loopback_stack_##i,						\
+		.stack_size = K_THREAD_STACK_SIZEOF(loopback_stack_##i),		\
+	};										\
+											\
+	static struct loopback_data loopback_data_##i = {				\
+		.held = loopback_held_##i,						\
+		.in_cb = loopback_in_cb_##i,						\
+	};										\
+											\
+	DEVICE_DT_INST_DEFINE(i, loopback_init, NULL, &loopback_data_##i,		\
+			      &loopback_config_##i, POST_KERNEL,			\
+			      CONFIG_IPC_SERVICE_REG_BACKEND_PRIORITY,			\
+			      &loopback_backend_ops);
+
+DT_INST_FOREACH_STATUS_OKAY(LOOPBACK_DEFINE)
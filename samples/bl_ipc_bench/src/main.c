@@ -0,0 +1,152 @@
+/*
+ * blue_leap IPC benchmark
+ *
+ * Measures the inter-core IPC primitives of blue_leap/common/isw. On
+ * native_sim both ends run in a single image over a loopback IPC backend;
+ * on the MIMXRT1160-EVK the M7 image drives the benchmarks and the M4 image
+ * answers over RPMsg. Every result is printed as one JSON object per line.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/printk.h>
+
+#include "bl_ipc_stream.h"
+#include "bl_isw.h"
+#include "bench.h"
+#include "bench_time.h"
+
+#define BENCH_STACK_SIZE	2048
+#define BENCH_PRIORITY		5
+
+/* Stream benchmark */
+#define STREAM_MEM_SIZE		0x4000
+#define STREAM_SAMPLES		1000000U
+#define STREAM_MAX_BATCH	64U
+
+K_THREAD_STACK_DEFINE(producer_stack, BENCH_STACK_SIZE);
+K_THREAD_STACK_DEFINE(consumer_stack, BENCH_STACK_SIZE);
+static struct k_thread producer_thread;
+static struct k_thread consumer_thread;
+
+/* Stands in for the shared SRAM region of the target */
+static uint8_t stream_mem[STREAM_MEM_SIZE] __aligned(BL_CACHE_LINE_SIZE);
+static bl_stream_t stream_tx;
+static bl_stream_t stream_rx;
+static uint32_t stream_batch;
+static uint32_t stream_checksum;
+
+static void stream_doorbell(void *arg)
+{
+	bl_stream_notify(arg);
+}
+
+static void stream_producer(void *p1, void *p2, void *p3)
+{
+	bl_adc_sample_t batch[STREAM_MAX_BATCH];
+	uint32_t sent = 0;
+
+	while (sent < STREAM_SAMPLES) {
+		uint32_t count = MIN(stream_batch, STREAM_SAMPLES - sent);
+		uint32_t done = 0;
+
+		for (uint32_t i = 0; i < count; i++) {
+			batch[i].timestamp = sent + i;
+			batch[i].voltage = (uint16_t)(sent + i);
+		}
+
+		while (done < count) {
+			done += bl_stream_write(&stream_tx, &batch[done], count - done);
+			if (done < count) {
+				/* Ring full: let the consumer drain it */
+				k_yield();
+			}
+		}
+		sent += count;
+	}
+
+	bl_stream_flush(&stream_tx);
+}
+
+static void stream_consumer(void *p1, void *p2, void *p3)
+{
+	bl_adc_sample_t batch[STREAM_MAX_BATCH];
+	uint32_t received = 0;
+	uint32_t sum = 0;
+
+	while (received < STREAM_SAMPLES) {
+		uint32_t count;
+
+		bl_stream_wait(&stream_rx, K_FOREVER);
+
+		count = bl_stream_read(&stream_rx, batch, ARRAY_SIZE(batch));
+		for (uint32_t i = 0; i < count; i++) {
+			sum += batch[i].timestamp;
+		}
+		received += count;
+	}
+
+	stream_checksum = sum;
+}
+
+static void bench_stream(uint32_t batch)
+{
+	uint32_t expected = 0;
+	uint64_t start, elapsed;
+
+	bl_stream_init(&stream_rx, stream_mem, sizeof(stream_mem), sizeof(bl_adc_sample_t), true);
+	bl_stream_init(&stream_tx, stream_mem, sizeof(stream_mem), sizeof(bl_adc_sample_t), false);
+	bl_stream_set_doorbell(&stream_tx, stream_doorbell, &stream_rx, BL_STREAM_DOORBELL_BATCH);
+	stream_batch = batch;
+
+	start = bench_time_ns();
+
+	k_thread_create(&consumer_thread, consumer_stack, K_THREAD_STACK_SIZEOF(consumer_stack),
+			stream_consumer, NULL, NULL, NULL, BENCH_PRIORITY, 0, K_NO_WAIT);
+	k_thread_create(&producer_thread, producer_stack, K_THREAD_STACK_SIZEOF(producer_stack),
+			stream_producer, NULL, NULL, NULL, BENCH_PRIORITY, 0, K_NO_WAIT);
+
+	/* Both threads have exited before they are created again for the next batch */
+	k_thread_join(&producer_thread, K_FOREVER);
+	k_thread_join(&consumer_thread, K_FOREVER);
+
+	elapsed = MAX(bench_time_ns() - start, 1U);
+
+	for (uint32_t i = 0; i < STREAM_SAMPLES; i++) {
+		expected += i;
+	}
+
+	printk("{\"bench\":\"stream\",\"batch\":%u,\"samples\":%u,\"ns\":%llu,"
+	       "\"samples_per_sec\":%llu,\"doorbells\":%u,\"ok\":%s}\n",
+	       batch, STREAM_SAMPLES, elapsed,
+	       (uint64_t)STREAM_SAMPLES * NSEC_PER_SEC / elapsed,
+	       stream_tx.stats.doorbells,
+	       (stream_checksum == expected) ? "true" : "false");
+}
+
+int main(void)
+{
+	static const uint32_t batches[] = { 1, 8, 32, STREAM_MAX_BATCH };
+
+	bench_time_init();
+	bench_ipc_init();
+
+	if (IS_ENABLED(CONFIG_SOC_MIMXRT1166_CM4)) {
+		/* The M4 image only answers the M7 initiator */
+		bench_ipc_serve();
+		return 0;
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(batches); i++) {
+		bench_stream(batches[i]);
+	}
+
+#if defined(BL_IPC_LOOPBACK)
+	bench_ipc_serve();
+#endif
+	bench_ipc_run();
+
+	printk("bench done\n");
+	return 0;
+}